@@ -0,0 +1,120 @@
+#ifndef CAVE_STD_BIT_VECTOR_H
+#define CAVE_STD_BIT_VECTOR_H
+
+#include <cstddef> // size_t
+#include <cstdint> // uint64_t
+
+#include "Containers/Config.h"
+#include "Containers/Vector.h"
+
+
+namespace cave {
+    // Dynamic bitset: 64 flags per word (a Vector<bool> takes a byte per flag).
+    // Counting, searching and the bulk operations between bitsets work on whole
+    // words (and SIMD registers when available), so they are very fast on big
+    // masks (visibility, component presence...).
+    class BitVector {
+    public:
+        static constexpr size_t npos = -1;
+        static constexpr size_t bitsPerWord = 64;
+
+        BitVector();
+        BitVector(size_t n, bool value = false);
+        BitVector(const BitVector& other);
+        BitVector(BitVector&& other) noexcept;
+        CAVE_CONTAINER_VIRTUAL ~BitVector();
+
+        BitVector& operator=(const BitVector& other);
+        BitVector& operator=(BitVector&& other) noexcept;
+
+        bool operator==(const BitVector& other) const;
+        bool operator!=(const BitVector& other) const;
+
+        bool operator[](size_t pos) const {
+            return (m_words.data()[pos / bitsPerWord] >> (pos % bitsPerWord)) & 1;
+        }
+        bool test(size_t pos) const {
+            return (*this)[pos];
+        }
+        // Same as test(), but throws cave::OutOfRangeException.
+        bool at(size_t pos) const;
+
+        void set(size_t pos, bool value = true){
+            uint64_t& word = m_words[pos / bitsPerWord];
+            const uint64_t bit = uint64_t(1) << (pos % bitsPerWord);
+            word = value ? (word | bit) : (word & ~bit);
+        }
+        void reset(size_t pos){
+            m_words[pos / bitsPerWord] &= ~(uint64_t(1) << (pos % bitsPerWord));
+        }
+        void flip(size_t pos){
+            m_words[pos / bitsPerWord] ^= uint64_t(1) << (pos % bitsPerWord);
+        }
+
+        // Sets (or clears) all the bits at once.
+        void setAll(bool value = true);
+        void flipAll();
+
+        void pushBack(bool value);
+        void popBack();
+
+        // For compatibility with the std style naming:
+        inline void push_back(bool value) { pushBack(value); }
+        inline void pop_back() { popBack(); }
+
+        // How many bits are set.
+        size_t count() const;
+        bool any() const;
+        bool none() const;
+        bool all() const;
+
+        // Position of the first set bit (or npos), and of the first set bit after
+        // pos. Ex: for (size_t i = b.findFirst(); i != b.npos; i = b.findNext(i))
+        size_t findFirst() const;
+        size_t findNext(size_t pos) const;
+
+        // Bulk operations. Both bitsets MUST have the same size (throws
+        // cave::OutOfRangeException otherwise).
+        BitVector& operator&=(const BitVector& other);
+        BitVector& operator|=(const BitVector& other);
+        BitVector& operator^=(const BitVector& other);
+        // this = this & ~other
+        BitVector& andNot(const BitVector& other);
+
+        size_t size() const {
+            return m_size;
+        }
+        bool empty() const {
+            return m_size == 0;
+        }
+        size_t capacity() const {
+            return m_words.capacity() * bitsPerWord;
+        }
+
+        // The raw words. The unused bits of the last one are always zero.
+        const uint64_t* words() const {
+            return m_words.data();
+        }
+        size_t wordCount() const {
+            return m_words.size();
+        }
+
+        // New bits get value.
+        void resize(size_t n, bool value = false);
+        void reserve(size_t n);
+        void clear();
+
+    private:
+        static size_t wordsFor(size_t bits){
+            return (bits + bitsPerWord - 1) / bitsPerWord;
+        }
+        // Zeroes the bits of the last word that are past the size.
+        void clearUnusedBits();
+        void checkSameSize(const BitVector& other) const;
+
+        Vector<uint64_t> m_words;
+        size_t m_size;
+    };
+}
+
+#endif // !CAVE_STD_BIT_VECTOR_H
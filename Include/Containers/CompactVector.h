@@ -0,0 +1,277 @@
+#ifndef CAVE_STD_COMPACT_VECTOR_H
+#define CAVE_STD_COMPACT_VECTOR_H
+
+#include <cstddef> // size_t
+#include <cstdint> // uint32_t
+#include <cstdlib> // malloc, free
+#include <utility> // std::move, std::forward
+#include <algorithm> // std::sort
+#include <initializer_list>
+
+#include "Containers/Memory.h"
+#include "Containers/Simd.h"
+#include "Containers/Exception.h"
+
+
+namespace cave {
+    // Vector for when you have LOTS of (usually small) vectors, like inside
+    // components: no vtable and 32 bits size and capacity, so the object itself
+    // is only 16 bytes (Vector is 32), and the first allocation only takes 4
+    // slots. It can't hold more than 4 billion elements.
+    template <typename T>
+    class CompactVector {
+    public:
+        static constexpr size_t npos = -1;
+        static constexpr size_t minAllocatedSlots = 4;
+        static constexpr size_t maxSize = 0xFFFFFFFF;
+
+        using Iterator = T*;
+        using ConstIterator = const T*;
+
+        CompactVector() : m_data(nullptr), m_size(0), m_allocated(0) {}
+        CompactVector(std::initializer_list<T> initList) : m_data(nullptr), m_size(0), m_allocated(0) {
+            reserve(initList.size());
+            for (const auto& obj: initList){
+                pushBack(obj);
+            }
+        }
+        CompactVector(const CompactVector& other) : m_data(nullptr), m_size(0), m_allocated(0) {
+            copyFrom(other);
+        }
+        CompactVector(CompactVector&& other) noexcept : m_data(other.m_data), m_size(other.m_size), m_allocated(other.m_allocated) {
+            other.m_data = nullptr;
+            other.m_size = 0;
+            other.m_allocated = 0;
+        }
+        // NOT virtual on purpose!
+        ~CompactVector(){
+            clear();
+            free(m_data);
+        }
+
+        CompactVector& operator=(const CompactVector& other){
+            if (this != &other){
+                clear();
+                copyFrom(other);
+            }
+            return *this;
+        }
+        CompactVector& operator=(CompactVector&& other) noexcept {
+            if (this != &other){
+                clear();
+                free(m_data);
+                m_data = other.m_data;
+                m_size = other.m_size;
+                m_allocated = other.m_allocated;
+                other.m_data = nullptr;
+                other.m_size = 0;
+                other.m_allocated = 0;
+            }
+            return *this;
+        }
+
+        bool operator==(const CompactVector& other) const {
+            if (m_size != other.m_size){
+                return false;
+            }
+            for (size_t i=0; i<m_size; i++){
+                if (m_data[i] != other.m_data[i]){
+                    return false;
+                }
+            }
+            return true;
+        }
+        bool operator!=(const CompactVector& other) const {
+            return !(*this == other);
+        }
+
+        Iterator begin() {
+            return m_data;
+        }
+        ConstIterator begin() const {
+            return m_data;
+        }
+        Iterator end() {
+            return m_data + m_size;
+        }
+        ConstIterator end() const {
+            return m_data + m_size;
+        }
+
+        T& front() {
+            return m_data[0];
+        }
+        const T& front() const {
+            return m_data[0];
+        }
+        T& back() {
+            return m_data[m_size - 1];
+        }
+        const T& back() const {
+            return m_data[m_size - 1];
+        }
+
+        T& operator[](size_t pos) {
+            return m_data[pos];
+        }
+        const T& operator[](size_t pos) const {
+            return m_data[pos];
+        }
+
+        T& at(size_t pos) {
+            if (pos >= m_size){
+                throw cave::OutOfRangeException(pos);
+            }
+            return m_data[pos];
+        }
+        const T& at(size_t pos) const {
+            if (pos >= m_size){
+                throw cave::OutOfRangeException(pos);
+            }
+            return m_data[pos];
+        }
+
+        void pushBack(const T& value){
+            emplaceBack(value);
+        }
+        void pushBack(T&& value){
+            emplaceBack(std::move(value));
+        }
+        template <typename... Args>
+        void emplaceBack(Args&&... args){
+            fitNewSize(size_t(m_size) + 1);
+            new(&m_data[m_size]) T(std::forward<Args>(args)...);
+            m_size++;
+        }
+
+        void popBack(){
+            if (m_size > 0){
+                m_size--;
+                m_data[m_size].~T();
+            }
+        }
+
+        void erase(size_t pos){
+            erase(pos, pos + 1);
+        }
+        void erase(size_t first, size_t last){
+            if (last > m_size){
+                last = m_size;
+            }
+            if (last <= first){ return; }
+            m_size = uint32_t(memory::eraseRange(m_data, m_size, first, last));
+        }
+        void eraseUnordered(size_t pos){
+            if (pos >= m_size){ return; } // Out of range: nothing to erase (like erase).
+
+            if (pos + 1 < m_size){
+                memory::moveSlot(m_data[pos], m_data[m_size - 1]);
+            }
+            popBack();
+        }
+
+        size_t findID(const T& object) const {
+            if constexpr (simd::IsAccelerated<T>::value){
+                const size_t id = simd::find(m_data, m_size, object);
+                return id < m_size ? id : npos;
+            }
+            else {
+                for (size_t i=0; i<m_size; i++){
+                    if (m_data[i] == object){
+                        return i;
+                    }
+                }
+                return npos;
+            }
+        }
+        bool contains(const T& object) const {
+            return findID(object) != npos;
+        }
+
+        void sort(){
+            std::sort(m_data, m_data + m_size);
+        }
+        template <class Compare>
+        void sort(Compare comp){
+            std::sort(m_data, m_data + m_size, comp);
+        }
+
+        size_t size() const {
+            return m_size;
+        }
+        bool empty() const {
+            return m_size == 0;
+        }
+        size_t capacity() const {
+            return m_allocated;
+        }
+
+        T* data() noexcept {
+            return m_data;
+        }
+        const T* data() const noexcept {
+            return m_data;
+        }
+
+        void reserve(size_t n){
+            fitNewSize(n);
+        }
+        void resize(size_t n){
+            if (n < m_size){
+                erase(n, m_size);
+                return;
+            }
+            fitNewSize(n);
+            for (size_t i=m_size; i<n; i++){
+                new(&m_data[i]) T();
+            }
+            m_size = uint32_t(n);
+        }
+        void shrinkToFit(){
+            fitNewSize(m_size, true);
+        }
+
+        void clear(){
+            for (size_t i=0; i<m_size; i++){
+                m_data[i].~T();
+            }
+            m_size = 0;
+        }
+
+    private:
+        void copyFrom(const CompactVector& other){
+            fitNewSize(other.m_size);
+            for (size_t i=0; i<other.m_size; i++){
+                new(&m_data[i]) T(other.m_data[i]);
+            }
+            m_size = other.m_size;
+        }
+
+        // Same growth policy as Vector, just with a smaller minimum.
+        void fitNewSize(size_t newSize, bool shrink=false){
+            if (newSize > m_allocated || shrink){
+                if (newSize > maxSize){
+                    throw cave::OutOfRangeException(newSize);
+                }
+                size_t v = memory::growCapacity(newSize, minAllocatedSlots);
+                if (v > maxSize){
+                    v = maxSize;
+                }
+
+                T* newData = (T*)malloc(v * sizeof(T));
+                if (m_data){
+                    memory::relocate(newData, m_data, m_size);
+                    free(m_data);
+                }
+                m_data = newData;
+                m_allocated = uint32_t(v);
+            }
+        }
+
+        T* m_data;
+        uint32_t m_size;
+        uint32_t m_allocated;
+    };
+}
+
+#endif // !CAVE_STD_COMPACT_VECTOR_H
@@ -0,0 +1,22 @@
+/*
+Build wide switches for the containers. They must be the same in every
+translation unit (define them in your build system, not before an #include).
+
+CAVE_CONTAINERS_NO_VTABLE:
+    By default the containers have virtual destructors, so they can be safely
+    extended and deleted through a base pointer. That costs one pointer (the
+    vptr) per container. Defining this removes them, making every Vector,
+    List, String, HashMap, Pair... 8 bytes smaller. Only do it if you never
+    delete a class derived from a container through a pointer to the container.
+*/
+
+#ifndef CAVE_STD_CONFIG_H
+#define CAVE_STD_CONFIG_H
+
+#ifdef CAVE_CONTAINERS_NO_VTABLE
+    #define CAVE_CONTAINER_VIRTUAL
+#else
+    #define CAVE_CONTAINER_VIRTUAL virtual
+#endif
+
+#endif // !CAVE_STD_CONFIG_H
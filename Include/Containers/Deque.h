@@ -0,0 +1,271 @@
+#ifndef CAVE_STD_DEQUE_H
+#define CAVE_STD_DEQUE_H
+
+#include <cstddef> // size_t
+#include <cstdlib> // malloc, free
+#include <utility> // std::move, std::forward
+#include <type_traits>
+#include <initializer_list>
+
+#include "Containers/Config.h"
+#include "Containers/Memory.h"
+#include "Containers/Span.h"
+#include "Containers/Exception.h"
+#include "Containers/IndexIterator.h"
+
+
+namespace cave {
+    // Double ended queue built as a growable ring buffer: pushing and popping at
+    // both ends is O(1), indexing is an add and a mask (the capacity is always a
+    // power of two) and the elements live in a single allocation. The contents
+    // are (at most) two contiguous spans: see firstSpan() and secondSpan().
+    template <typename T>
+    class Deque {
+    public:
+        static constexpr size_t npos = -1;
+        static constexpr size_t minAllocatedSlots = 16;
+
+        Deque() : m_data(nullptr), m_head(0), m_size(0), m_allocated(0) {}
+        Deque(std::initializer_list<T> initList) : Deque() {
+            reserve(initList.size());
+            for (const auto& obj: initList){
+                pushBack(obj);
+            }
+        }
+        Deque(const Deque& other) : Deque() {
+            copyFrom(other);
+        }
+        Deque(Deque&& other) noexcept : m_data(other.m_data), m_head(other.m_head), m_size(other.m_size), m_allocated(other.m_allocated) {
+            other.m_data = nullptr;
+            other.m_head = 0;
+            other.m_size = 0;
+            other.m_allocated = 0;
+        }
+        CAVE_CONTAINER_VIRTUAL ~Deque(){
+            clear();
+            free(m_data);
+        }
+
+        Deque& operator=(const Deque& other){
+            if (this != &other){
+                clear();
+                copyFrom(other);
+            }
+            return *this;
+        }
+        Deque& operator=(Deque&& other) noexcept {
+            if (this != &other){
+                clear();
+                free(m_data);
+                m_data = other.m_data;
+                m_head = other.m_head;
+                m_size = other.m_size;
+                m_allocated = other.m_allocated;
+                other.m_data = nullptr;
+                other.m_head = 0;
+                other.m_size = 0;
+                other.m_allocated = 0;
+            }
+            return *this;
+        }
+
+        bool operator==(const Deque& other) const {
+            if (m_size != other.m_size){
+                return false;
+            }
+            for (size_t i=0; i<m_size; i++){
+                if ((*this)[i] != other[i]){
+                    return false;
+                }
+            }
+            return true;
+        }
+        bool operator!=(const Deque& other) const {
+            return !(*this == other);
+        }
+
+        using Iterator = IndexIterator<Deque, false>;
+        using ConstIterator = IndexIterator<Deque, true>;
+
+        Iterator begin() {
+            return Iterator(this, 0);
+        }
+        ConstIterator begin() const {
+            return ConstIterator(this, 0);
+        }
+        Iterator end() {
+            return Iterator(this, m_size);
+        }
+        ConstIterator end() const {
+            return ConstIterator(this, m_size);
+        }
+
+        T& operator[](size_t pos) {
+            return m_data[(m_head + pos) & (m_allocated - 1)];
+        }
+        const T& operator[](size_t pos) const {
+            return m_data[(m_head + pos) & (m_allocated - 1)];
+        }
+
+        T& at(size_t pos) {
+            if (pos >= m_size){
+                throw cave::OutOfRangeException(pos);
+            }
+            return (*this)[pos];
+        }
+        const T& at(size_t pos) const {
+            if (pos >= m_size){
+                throw cave::OutOfRangeException(pos);
+            }
+            return (*this)[pos];
+        }
+
+        T& front() {
+            return m_data[m_head];
+        }
+        const T& front() const {
+            return m_data[m_head];
+        }
+        T& back() {
+            return (*this)[m_size - 1];
+        }
+        const T& back() const {
+            return (*this)[m_size - 1];
+        }
+
+        void pushBack(const T& value){
+            emplaceBack(value);
+        }
+        void pushBack(T&& value){
+            emplaceBack(std::move(value));
+        }
+        template <typename... Args>
+        T& emplaceBack(Args&&... args){
+            fitNewSize(m_size + 1);
+            T* slot = &(*this)[m_size];
+            new(slot) T(std::forward<Args>(args)...);
+            m_size++;
+            return *slot;
+        }
+
+        void pushFront(const T& value){
+            emplaceFront(value);
+        }
+        void pushFront(T&& value){
+            emplaceFront(std::move(value));
+        }
+        template <typename... Args>
+        T& emplaceFront(Args&&... args){
+            fitNewSize(m_size + 1);
+            const size_t head = (m_head - 1) & (m_allocated - 1);
+            new(&m_data[head]) T(std::forward<Args>(args)...);
+            m_head = head;
+            m_size++;
+            return m_data[head];
+        }
+
+        void popBack(){
+            if (m_size > 0){
+                m_size--;
+                (*this)[m_size].~T();
+            }
+        }
+        void popFront(){
+            if (m_size > 0){
+                m_data[m_head].~T();
+                m_head = (m_head + 1) & (m_allocated - 1);
+                m_size--;
+            }
+        }
+
+        // For compatibility with the std style naming:
+        inline void push_back(const T& value) { pushBack(value); }
+        inline void push_back(T&& value) { pushBack(std::move(value)); }
+        template<typename... Args>
+        inline void emplace_back(Args&&... args) { emplaceBack(std::forward<Args>(args)...); }
+        inline void push_front(const T& value) { pushFront(value); }
+        inline void push_front(T&& value) { pushFront(std::move(value)); }
+        template<typename... Args>
+        inline void emplace_front(Args&&... args) { emplaceFront(std::forward<Args>(args)...); }
+        inline void pop_back() { popBack(); }
+        inline void pop_front() { popFront(); }
+
+        // The contents are firstSpan() followed by secondSpan() (which is empty
+        // unless the elements wrap around the end of the buffer). Handy to copy
+        // everything with two memcpy's.
+        Span<T> firstSpan() {
+            return Span<T>(m_data + m_head, firstSpanSize());
+        }
+        Span<const T> firstSpan() const {
+            return Span<const T>(m_data + m_head, firstSpanSize());
+        }
+        Span<T> secondSpan() {
+            return Span<T>(m_data, m_size - firstSpanSize());
+        }
+        Span<const T> secondSpan() const {
+            return Span<const T>(m_data, m_size - firstSpanSize());
+        }
+
+        size_t size() const {
+            return m_size;
+        }
+        bool empty() const {
+            return m_size == 0;
+        }
+        size_t capacity() const {
+            return m_allocated;
+        }
+
+        void reserve(size_t n){
+            fitNewSize(n);
+        }
+
+        void clear(){
+            for (size_t i=0; i<m_size; i++){
+                (*this)[i].~T();
+            }
+            m_head = 0;
+            m_size = 0;
+        }
+
+    private:
+        size_t firstSpanSize() const {
+            const size_t untilEnd = m_allocated - m_head;
+            return m_size < untilEnd ? m_size : untilEnd;
+        }
+
+        void copyFrom(const Deque& other){
+            fitNewSize(other.m_size);
+            for (size_t i=0; i<other.m_size; i++){
+                new(&m_data[i]) T(other[i]);
+            }
+            m_head = 0;
+            m_size = other.m_size;
+        }
+
+        // Same growth policy as Vector (so the capacity is a power of two). The
+        // elements are unwrapped into the new buffer, starting at zero.
+        void fitNewSize(size_t newSize){
+            if (newSize > m_allocated){
+                const size_t v = memory::growCapacity(newSize, minAllocatedSlots);
+                T* newData = (T*)malloc(v * sizeof(T));
+                if (m_data){
+                    const size_t first = firstSpanSize();
+                    memory::relocate(newData, m_data + m_head, first);
+                    memory::relocate(newData + first, m_data, m_size - first);
+                    free(m_data);
+                }
+                m_data = newData;
+                m_head = 0;
+                m_allocated = v;
+            }
+        }
+
+        T* m_data;
+        size_t m_head;
+        size_t m_size;
+        size_t m_allocated;
+    };
+}
+
+#endif // !CAVE_STD_DEQUE_H
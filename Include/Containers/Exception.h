@@ -17,6 +17,14 @@ namespace cave{
 
         size_t pos;
     };
+
+    class FormatException : public Exception {
+    public:
+        FormatException(const char* msg = "");
+        virtual ~FormatException();
+
+        const char* message; // Always a string literal.
+    };
 }
 
 #endif // !CAVE_EXCEPTION_H
\ No newline at end of file
@@ -0,0 +1,152 @@
+#ifndef CAVE_STD_EYTZINGER_ARRAY_H
+#define CAVE_STD_EYTZINGER_ARRAY_H
+
+#include <cstddef> // size_t
+#include <cstdint> // uint64_t, uintptr_t
+
+#include "Containers/Config.h"
+#include "Containers/Vector.h"
+#include "Containers/Simd.h"
+
+
+namespace cave {
+    // Read only copy of a sorted array, stored in BFS order (like a binary heap:
+    // the children of k are 2k and 2k+1) so binary searches are cache friendly.
+    // The top of the tree is always hot in the cache, the next levels are
+    // prefetched while searching and the loop has no branches to mispredict.
+    // Much faster than Vector::lowerBound on big arrays, not worth it on tiny ones.
+    // Ex:  cave::EytzingerArray<float> times(sortedKeyframeTimes);
+    //      size_t keyframe = times.lowerBound(t);
+    template <typename T>
+    class EytzingerArray {
+    public:
+        static constexpr size_t npos = -1;
+
+        EytzingerArray() {}
+        // The source MUST be sorted (by operator<).
+        EytzingerArray(const Vector<T>& sorted) {
+            build(sorted.data(), sorted.size());
+        }
+        EytzingerArray(const T* sorted, size_t n) {
+            build(sorted, n);
+        }
+        CAVE_CONTAINER_VIRTUAL ~EytzingerArray() {}
+
+        void build(const Vector<T>& sorted){
+            build(sorted.data(), sorted.size());
+        }
+        void build(const T* sorted, size_t n){
+            m_keys.clear();
+            if (n == 0){
+                return;
+            }
+            // Slot 0 is unused by the tree (a failed search ends there).
+            m_keys.resize(n + 1);
+            fill(sorted, n, 0, 1);
+        }
+
+        // Position (in the sorted source) of the first element not less than
+        // value, or size() if there is none. Same result as Vector::lowerBound.
+        size_t lowerBound(const T& value) const {
+            if (m_keys.empty()){
+                return 0;
+            }
+            return rankOf(searchLower(value));
+        }
+        // Position of the first element greater than value, or size().
+        size_t upperBound(const T& value) const {
+            if (m_keys.empty()){
+                return 0;
+            }
+            const T* keys = m_keys.data();
+            const size_t n = size();
+            size_t k = 1;
+            while (k <= n){
+                prefetchChildren(k);
+                k = 2 * k + !(value < keys[k]);
+            }
+            return rankOf(finalSlot(k));
+        }
+
+        bool contains(const T& value) const {
+            const size_t k = searchLower(value);
+            return k != 0 && !(value < m_keys.data()[k]);
+        }
+
+        size_t size() const {
+            return m_keys.empty() ? 0 : m_keys.size() - 1;
+        }
+        bool empty() const {
+            return size() == 0;
+        }
+
+        // The elements in BFS order (starting at index 1).
+        const Vector<T>& keys() const {
+            return m_keys;
+        }
+
+        void clear(){
+            m_keys.clear();
+        }
+
+    private:
+        // How many elements fit in a cache line: prefetching keys[k * stride]
+        // loads the 4 (for 4 bytes keys) levels below k in a single go.
+        static constexpr size_t prefetchStride = sizeof(T) < 64 ? 64 / sizeof(T) : 1;
+
+        // In order walk of the implicit tree, so the slots get the sorted values.
+        size_t fill(const T* sorted, size_t n, size_t i, size_t k){
+            if (k <= n){
+                i = fill(sorted, n, i, 2 * k);
+                m_keys[k] = sorted[i++];
+                i = fill(sorted, n, i, 2 * k + 1);
+            }
+            return i;
+        }
+
+        // Slot of the lower bound (0 if none). Works on an empty array too.
+        size_t searchLower(const T& value) const {
+            const T* keys = m_keys.data();
+            const size_t n = size();
+            size_t k = 1;
+            while (k <= n){
+                prefetchChildren(k);
+                k = 2 * k + (keys[k] < value);
+            }
+            return finalSlot(k);
+        }
+
+        // Position in the sorted source of the element at slot k (size() for the
+        // slot 0), computed instead of loaded so a search touches nothing but the
+        // keys: it's the in order position of k in a perfect tree of the same
+        // height, minus the empty slots of the last level that come before it.
+        size_t rankOf(size_t k) const {
+            const size_t n = size();
+            if (k == 0){
+                return n;
+            }
+            const unsigned int height = simd::highestBit64(uint64_t(n));
+            const unsigned int depth = simd::highestBit64(uint64_t(k));
+            const size_t rank = ((2 * (k - (size_t(1) << depth)) + 1) << (height - depth)) - 1;
+            // The slot p of the last level is at 2p in the perfect tree.
+            const size_t lastLevelSize = n - ((size_t(1) << height) - 1);
+            const size_t lastLevelBefore = (rank + 1) / 2;
+            return lastLevelBefore > lastLevelSize ? rank - (lastLevelBefore - lastLevelSize) : rank;
+        }
+
+        // Every "go right" step appended a 1 bit to k, so the answer is where we
+        // last went left: drop the trailing ones and that left step (0 = none).
+        static size_t finalSlot(size_t k){
+            return size_t(uint64_t(k) >> (simd::countTrailingZeros64(~uint64_t(k)) + 1));
+        }
+
+        void prefetchChildren(size_t k) const {
+            // Integer math, since the address may be past the end of the array.
+            simd::prefetch((const void*)(uintptr_t(m_keys.data()) + k * prefetchStride * sizeof(T)));
+        }
+
+        Vector<T> m_keys;
+    };
+}
+
+#endif // !CAVE_STD_EYTZINGER_ARRAY_H
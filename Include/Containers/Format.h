@@ -0,0 +1,552 @@
+/*
+Type safe string formatting, like std::format but writing straight into a
+cave::String, a cave::StringBuilder or a fixed (stack) buffer:
+
+    cave::String msg = cave::format("{} at {:.3f}", name, value);
+    cave::formatTo(logLine, "[{:>8}] {}\n", category, text);
+
+The replacement fields are "{}" or "{:spec}", where the spec is
+[[fill]align][0][width][.precision][type]. Align is '<', '>' or '^'; the type
+is one of d x X b o c (integers), f e g (floats) or s (text). Use "{{" and "}}"
+for the braces themselves. The arguments are used in order (no "{0}" ids).
+
+A bad spec, a spec that doesn't fit its argument (like "{:.3f}" for a text or
+"{:d}" for a float) or a wrong amount of arguments throws a
+cave::FormatException. To get those errors at compile time instead, wrap the format string with
+CAVE_FORMAT() (works in C++17):
+
+    cave::String msg = cave::format(CAVE_FORMAT("{} at {:.3f}"), name, value);
+
+When compiled as C++20 (consteval) every literal format string is checked at
+compile time, with or without CAVE_FORMAT(). Format strings that are only
+known at runtime must be wrapped with cave::runtimeFormat().
+
+To format your own types, specialize cave::Formatter (see the ones below).
+*/
+
+#ifndef CAVE_STD_FORMAT_H
+#define CAVE_STD_FORMAT_H
+
+#include <cstddef> // size_t
+#include <string>  // std::string
+#include <type_traits>
+
+#include "Containers/String.h"
+#include "Containers/StringView.h"
+#include "Containers/StringBuilder.h"
+#include "Containers/Exception.h"
+#include "Containers/Vector.h"
+#include "Containers/Span.h"
+#include "Containers/Pair.h"
+#include "Containers/Name.h"
+#include "Containers/SharedString.h"
+
+#if defined(__cpp_consteval)
+    #define CAVE_FORMAT_CONSTEVAL consteval
+    #define CAVE_FORMAT_COMPILE_CHECKS 1
+#else
+    #define CAVE_FORMAT_CONSTEVAL constexpr
+#endif
+
+
+namespace cave {
+    // What is inside the braces of a replacement field.
+    struct FormatSpec {
+        char fill = ' ';
+        char align = 0; // '<', '>', '^' or zero for the default (numbers right, text left).
+        bool zeroPad = false;
+        size_t width = 0;
+        int precision = -1;
+        char type = 0;
+    };
+
+    // Where the formatted text goes.
+    class FormatOutput {
+    public:
+        virtual ~FormatOutput() {}
+
+        virtual void write(const char* str, size_t size) = 0;
+
+        // Writes str filled up to spec.width (following the fill, align and zero
+        // padding of the spec). defaultAlign is used when the spec has none.
+        void writePadded(StringView str, const FormatSpec& spec, char defaultAlign);
+        void writeFill(char c, size_t count);
+    };
+
+    // Specialize it to format your own types:
+    //   template <> struct cave::Formatter<Vec3> {
+    //       static void format(cave::FormatOutput& out, const Vec3& v, const cave::FormatSpec& spec) { ... }
+    //   };
+    template <typename T, typename Enable = void>
+    struct Formatter {
+        static_assert(!std::is_same<T, T>::value, "There is no cave::Formatter for this type.");
+    };
+
+    namespace formatting {
+        // NOT constexpr on purpose: reaching it while a format string is being
+        // checked at compile time is what makes the compilation fail. At runtime
+        // it throws a cave::FormatException.
+        [[noreturn]] void formatError(const char* message);
+
+        constexpr bool isDigit(char c) {
+            return c >= '0' && c <= '9';
+        }
+        constexpr bool isAlign(char c) {
+            return c == '<' || c == '>' || c == '^';
+        }
+        constexpr bool isType(char c) {
+            return c == 'd' || c == 'x' || c == 'X' || c == 'b' || c == 'o' || c == 'c' ||
+                   c == 'f' || c == 'e' || c == 'g' || c == 's';
+        }
+
+        // Parses the spec in [it, end), which is what's between the ':' and the '}'.
+        constexpr FormatSpec parseSpec(const char* it, const char* end) {
+            FormatSpec spec;
+            if (end - it >= 2 && isAlign(it[1])){
+                spec.fill = it[0];
+                spec.align = it[1];
+                it += 2;
+            }
+            else if (it != end && isAlign(*it)){
+                spec.align = *it;
+                it++;
+            }
+            if (it != end && *it == '0'){
+                spec.zeroPad = true;
+                it++;
+            }
+            while (it != end && isDigit(*it)){
+                spec.width = spec.width * 10 + size_t(*it - '0');
+                it++;
+            }
+            if (it != end && *it == '.'){
+                it++;
+                if (it == end || !isDigit(*it)){
+                    formatError("Missing the precision after the '.' of a format spec.");
+                }
+                spec.precision = 0;
+                while (it != end && isDigit(*it)){
+                    spec.precision = spec.precision * 10 + (*it - '0');
+                    it++;
+                }
+            }
+            if (it != end && isType(*it)){
+                spec.type = *it;
+                it++;
+            }
+            if (it != end){
+                formatError("Invalid format spec.");
+            }
+            return spec;
+        }
+
+        // Walks the format string calling onText(str, size) for the literal parts
+        // and onField(index, spec) for every replacement field. Returns how many
+        // fields there are. Used both by the compile time check and the runtime.
+        template <typename OnText, typename OnField>
+        constexpr size_t parseFormat(const char* it, const char* end, OnText&& onText, OnField&& onField) {
+            size_t fieldCount = 0;
+            const char* text = it;
+            while (it != end){
+                if (*it == '{'){
+                    if (it + 1 != end && it[1] == '{'){
+                        onText(text, size_t(it + 1 - text));
+                        it += 2;
+                        text = it;
+                        continue;
+                    }
+                    onText(text, size_t(it - text));
+                    const char* close = it + 1;
+                    while (close != end && *close != '}'){
+                        close++;
+                    }
+                    if (close == end){
+                        formatError("Missing a '}' in the format string.");
+                    }
+                    FormatSpec spec;
+                    if (close != it + 1){
+                        if (it[1] != ':'){
+                            formatError("Only {} and {:spec} are supported (no argument ids).");
+                        }
+                        spec = parseSpec(it + 2, close);
+                    }
+                    onField(fieldCount++, spec);
+                    it = close + 1;
+                    text = it;
+                }
+                else if (*it == '}'){
+                    if (it + 1 == end || it[1] != '}'){
+                        formatError("A lonely '}' in the format string (use '}}').");
+                    }
+                    onText(text, size_t(it + 1 - text));
+                    it += 2;
+                    text = it;
+                }
+                else {
+                    it++;
+                }
+            }
+            onText(text, size_t(it - text));
+            return fieldCount;
+        }
+
+        constexpr size_t lengthOf(const char* str, size_t maxLength) {
+            size_t n = 0;
+            while (n < maxLength && str[n] != '\0'){
+                n++;
+            }
+            return n;
+        }
+
+        struct RuntimeFormat {
+            StringView str;
+        };
+
+        // The base of the types CAVE_FORMAT() creates, which carry the format
+        // string in their type (so it's known at compile time, even in C++17).
+        struct CompiledFormat {};
+
+        // An argument with its type erased (so the engine isn't a template).
+        struct FormatArg {
+            const void* value = nullptr;
+            void (*format)(FormatOutput& out, const void* value, const FormatSpec& spec) = nullptr;
+        };
+
+        template <typename T>
+        void formatErased(FormatOutput& out, const void* value, const FormatSpec& spec) {
+            Formatter<T>::format(out, *static_cast<const T*>(value), spec);
+        }
+        void formatCString(FormatOutput& out, const void* value, const FormatSpec& spec);
+
+        template <typename T>
+        FormatArg makeArg(const T& value) {
+            FormatArg arg;
+            arg.value = &value;
+            arg.format = &formatErased<T>;
+            return arg;
+        }
+        // String literals and char buffers.
+        template <size_t N>
+        FormatArg makeArg(const char (&value)[N]) {
+            FormatArg arg;
+            arg.value = value;
+            arg.format = &formatCString;
+            return arg;
+        }
+
+        void formatTo(FormatOutput& out, StringView fmt, const FormatArg* args, size_t count);
+        // Formats into a String doing (at most) a single allocation.
+        String formatToString(StringView fmt, const FormatArg* args, size_t count);
+        // Like snprintf: writes (and null terminates) what fits and returns the full size.
+        size_t formatToBuffer(char* buffer, size_t size, StringView fmt, const FormatArg* args, size_t count);
+
+        void formatInteger(FormatOutput& out, long long value, const FormatSpec& spec);
+        void formatInteger(FormatOutput& out, unsigned long long value, const FormatSpec& spec);
+        void formatFloat(FormatOutput& out, float value, const FormatSpec& spec);
+        void formatFloat(FormatOutput& out, double value, const FormatSpec& spec);
+        void formatText(FormatOutput& out, StringView value, const FormatSpec& spec);
+
+        template <typename Iter>
+        void formatRange(FormatOutput& out, Iter first, Iter last, const FormatSpec& spec) {
+            using T = typename std::decay<decltype(*first)>::type;
+            out.write("[", 1);
+            for (Iter it = first; it != last; ++it){
+                if (it != first){
+                    out.write(", ", 2);
+                }
+                Formatter<T>::format(out, *it, spec);
+            }
+            out.write("]", 1);
+        }
+
+        template <typename T>
+        struct Identity {
+            using type = T;
+        };
+
+        // What the built in formatters accept for each kind of argument, so the
+        // specs can be checked against the argument types at compile time.
+        enum class ArgType {
+            Integer, // d x X b o c, no precision.
+            Float,   // f e g, any precision.
+            Text,    // s, the precision is the max amount of chars.
+            Char,    // c (as text) or d x X b o (as an integer).
+            Bool,    // Like a text.
+            Custom,  // Your own Formatter (its spec is only checked by it, at runtime).
+        };
+
+        template <typename T>
+        struct IsFormatText : std::false_type {};
+        template <> struct IsFormatText<const char*> : std::true_type {};
+        template <> struct IsFormatText<char*> : std::true_type {};
+        template <> struct IsFormatText<StringView> : std::true_type {};
+        template <> struct IsFormatText<String> : std::true_type {};
+        template <> struct IsFormatText<std::string> : std::true_type {};
+        template <> struct IsFormatText<Name> : std::true_type {};
+        template <bool Atomic> struct IsFormatText<BasicSharedString<Atomic>> : std::true_type {};
+
+        template <typename T>
+        constexpr ArgType argTypeOf() {
+            if constexpr (std::is_same<T, bool>::value){
+                return ArgType::Bool;
+            }
+            else if constexpr (std::is_same<T, char>::value){
+                return ArgType::Char;
+            }
+            else if constexpr (std::is_integral<T>::value){
+                return ArgType::Integer;
+            }
+            else if constexpr (std::is_floating_point<T>::value){
+                return ArgType::Float;
+            }
+            else if constexpr (IsFormatText<T>::value){
+                return ArgType::Text;
+            }
+            else {
+                return ArgType::Custom;
+            }
+        }
+
+        // The same checks the built in formatters do while formatting.
+        constexpr void checkSpec(const FormatSpec& spec, ArgType type) {
+            const bool integerType = spec.type == 0 || spec.type == 'd' || spec.type == 'x' ||
+                spec.type == 'X' || spec.type == 'b' || spec.type == 'o' || spec.type == 'c';
+            const bool textType = spec.type == 0 || spec.type == 's';
+            switch (type){
+                case ArgType::Integer:
+                    if (!integerType){
+                        formatError("Invalid format type for an integer.");
+                    }
+                    if (spec.precision >= 0){
+                        formatError("Integers don't take a precision.");
+                    }
+                    break;
+                case ArgType::Float:
+                    if (spec.type != 0 && spec.type != 'f' && spec.type != 'e' && spec.type != 'g'){
+                        formatError("Invalid format type for a float.");
+                    }
+                    break;
+                case ArgType::Char:
+                    if (spec.type != 0 && spec.type != 'c'){
+                        checkSpec(spec, ArgType::Integer);
+                    }
+                    break;
+                case ArgType::Text:
+                case ArgType::Bool:
+                    if (!textType){
+                        formatError("Invalid format type for a text.");
+                    }
+                    break;
+                case ArgType::Custom:
+                    break;
+            }
+        }
+
+        // True if the format string has a field for every argument. A malformed
+        // one (or a spec that doesn't fit its argument's type) reaches
+        // formatError(), so it's not a constant expression (and doesn't compile).
+        template <typename... Args>
+        constexpr bool checkFormat(const char* str, size_t size) {
+            const ArgType types[] = {argTypeOf<Args>()..., ArgType::Custom};
+            const size_t count = sizeof...(Args);
+            return parseFormat(str, str + size, [](const char*, size_t) {},
+                [&types, count](size_t index, const FormatSpec& spec) {
+                    if (index < count){
+                        checkSpec(spec, types[index]);
+                    }
+                }) == count;
+        }
+    }
+
+    // The format string, checked against the argument types (see the top of the file).
+    template <typename... Args>
+    class BasicFormatString {
+    public:
+        template <size_t N>
+        CAVE_FORMAT_CONSTEVAL BasicFormatString(const char (&str)[N]) : m_data(str), m_size(formatting::lengthOf(str, N)) {
+#if defined(CAVE_FORMAT_COMPILE_CHECKS)
+            if (!formatting::checkFormat<Args...>(m_data, m_size)){
+                formatting::formatError("The amount of {} doesn't match the amount of arguments.");
+            }
+#endif
+        }
+        // From CAVE_FORMAT(), checked at compile time in any standard.
+        template <typename S, typename = typename std::enable_if<std::is_base_of<formatting::CompiledFormat, S>::value>::type>
+        constexpr BasicFormatString(S) : m_data(S::data()), m_size(S::size()) {
+            static_assert(formatting::checkFormat<Args...>(S::data(), S::size()),
+                "The amount of {} doesn't match the amount of arguments.");
+        }
+        BasicFormatString(formatting::RuntimeFormat fmt) : m_data(fmt.str.data()), m_size(fmt.str.size()) {}
+
+        StringView view() const {
+            return StringView(m_data, m_size);
+        }
+
+    private:
+        // (Not a StringView, which can't be used at compile time.)
+        const char* m_data;
+        size_t m_size;
+    };
+
+    // Not deduced from the format string (only from the arguments).
+    template <typename... Args>
+    using FormatString = typename formatting::Identity<BasicFormatString<typename std::decay<Args>::type...>>::type;
+
+    // For format strings that are only known at runtime (checked while formatting).
+    inline formatting::RuntimeFormat runtimeFormat(StringView fmt) {
+        return formatting::RuntimeFormat{fmt};
+    }
+
+    // Checks a literal format string at compile time (see the top of the file).
+    // Ex:  cave::format(CAVE_FORMAT("{} hp"), hp);      // Ok.
+    //      cave::format(CAVE_FORMAT("{} hp {}"), hp);   // Doesn't compile.
+    #define CAVE_FORMAT(str) [] { \
+            struct CompiledStr : cave::formatting::CompiledFormat { \
+                static constexpr const char* data() { return str; } \
+                static constexpr std::size_t size() { return cave::formatting::lengthOf(str, sizeof(str)); } \
+            }; \
+            return CompiledStr(); \
+        }()
+
+    template <typename... Args>
+    String format(FormatString<Args...> fmt, const Args&... args) {
+        const formatting::FormatArg list[] = {formatting::makeArg(args)..., formatting::FormatArg()};
+        return formatting::formatToString(fmt.view(), list, sizeof...(Args));
+    }
+
+    // Appends to out.
+    template <typename... Args>
+    void formatTo(String& out, FormatString<Args...> fmt, const Args&... args) {
+        struct Output : FormatOutput {
+            explicit Output(String& str) : m_str(str) {}
+            void write(const char* str, size_t size) override { m_str.append(str, size); }
+            String& m_str;
+        } output(out);
+        const formatting::FormatArg list[] = {formatting::makeArg(args)..., formatting::FormatArg()};
+        formatting::formatTo(output, fmt.view(), list, sizeof...(Args));
+    }
+    template <typename... Args>
+    void formatTo(StringBuilder& out, FormatString<Args...> fmt, const Args&... args) {
+        struct Output : FormatOutput {
+            explicit Output(StringBuilder& sb) : m_sb(sb) {}
+            void write(const char* str, size_t size) override { m_sb.append(StringView(str, size)); }
+            StringBuilder& m_sb;
+        } output(out);
+        const formatting::FormatArg list[] = {formatting::makeArg(args)..., formatting::FormatArg()};
+        formatting::formatTo(output, fmt.view(), list, sizeof...(Args));
+    }
+    // Into a fixed buffer (never allocates). Like snprintf, it writes what fits
+    // (always null terminated) and returns the size the whole text would have.
+    template <typename... Args>
+    size_t formatTo(char* buffer, size_t size, FormatString<Args...> fmt, const Args&... args) {
+        const formatting::FormatArg list[] = {formatting::makeArg(args)..., formatting::FormatArg()};
+        return formatting::formatToBuffer(buffer, size, fmt.view(), list, sizeof...(Args));
+    }
+
+    // Built in formatters:
+
+    template <typename T>
+    struct Formatter<T, typename std::enable_if<std::is_integral<T>::value &&
+        !std::is_same<T, bool>::value && !std::is_same<T, char>::value>::type> {
+        static void format(FormatOutput& out, T value, const FormatSpec& spec) {
+            if constexpr (std::is_signed<T>::value){
+                formatting::formatInteger(out, (long long)value, spec);
+            }
+            else {
+                formatting::formatInteger(out, (unsigned long long)value, spec);
+            }
+        }
+    };
+    template <typename T>
+    struct Formatter<T, typename std::enable_if<std::is_floating_point<T>::value>::type> {
+        static void format(FormatOutput& out, T value, const FormatSpec& spec) {
+            if constexpr (std::is_same<T, float>::value){
+                formatting::formatFloat(out, value, spec);
+            }
+            else {
+                formatting::formatFloat(out, double(value), spec);
+            }
+        }
+    };
+    template <>
+    struct Formatter<bool> {
+        static void format(FormatOutput& out, bool value, const FormatSpec& spec) {
+            formatting::formatText(out, value ? StringView("true") : StringView("false"), spec);
+        }
+    };
+    template <>
+    struct Formatter<char> {
+        static void format(FormatOutput& out, char value, const FormatSpec& spec) {
+            if (spec.type != 0 && spec.type != 'c'){
+                formatting::formatInteger(out, (long long)value, spec);
+                return;
+            }
+            formatting::formatText(out, StringView(&value, 1), spec);
+        }
+    };
+    template <>
+    struct Formatter<const char*> {
+        static void format(FormatOutput& out, const char* value, const FormatSpec& spec) {
+            formatting::formatText(out, StringView(value), spec);
+        }
+    };
+    template <>
+    struct Formatter<char*> : Formatter<const char*> {};
+    template <>
+    struct Formatter<StringView> {
+        static void format(FormatOutput& out, StringView value, const FormatSpec& spec) {
+            formatting::formatText(out, value, spec);
+        }
+    };
+    template <>
+    struct Formatter<String> {
+        static void format(FormatOutput& out, const String& value, const FormatSpec& spec) {
+            formatting::formatText(out, value.view(), spec);
+        }
+    };
+    template <>
+    struct Formatter<std::string> {
+        static void format(FormatOutput& out, const std::string& value, const FormatSpec& spec) {
+            formatting::formatText(out, StringView(value), spec);
+        }
+    };
+    template <>
+    struct Formatter<Name> {
+        static void format(FormatOutput& out, Name value, const FormatSpec& spec) {
+            formatting::formatText(out, value.view(), spec);
+        }
+    };
+    template <bool Atomic>
+    struct Formatter<BasicSharedString<Atomic>> {
+        static void format(FormatOutput& out, const BasicSharedString<Atomic>& value, const FormatSpec& spec) {
+            formatting::formatText(out, value.view(), spec);
+        }
+    };
+
+    // Containers are written as [a, b, c], with the spec applied to every element.
+    template <typename T>
+    struct Formatter<Vector<T>> {
+        static void format(FormatOutput& out, const Vector<T>& value, const FormatSpec& spec) {
+            formatting::formatRange(out, value.begin(), value.end(), spec);
+        }
+    };
+    template <typename T>
+    struct Formatter<Span<T>> {
+        static void format(FormatOutput& out, const Span<T>& value, const FormatSpec& spec) {
+            formatting::formatRange(out, value.begin(), value.end(), spec);
+        }
+    };
+    // Pairs are written as (first, second).
+    template <typename T1, typename T2>
+    struct Formatter<Pair<T1, T2>> {
+        static void format(FormatOutput& out, const Pair<T1, T2>& value, const FormatSpec& spec) {
+            out.write("(", 1);
+            Formatter<T1>::format(out, value.first, spec);
+            out.write(", ", 2);
+            Formatter<T2>::format(out, value.second, spec);
+            out.write(")", 1);
+        }
+    };
+}
+
+#endif // !CAVE_STD_FORMAT_H
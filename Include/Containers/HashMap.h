@@ -1,21 +1,39 @@
 #ifndef CAVE_STD_HASH_TABLE_H
 #define CAVE_STD_HASH_TABLE_H
 
-#include <cstddef> // size_t
+#include <cstddef> // size_t, std::ptrdiff_t
+#include <iterator> // std::bidirectional_iterator_tag
+#include <type_traits> // std::conditional
 #include <utility> // std::move, std::forward
 #include <cstdlib> // malloc, free
 
+#include "Containers/Config.h"
 #include "Containers/Vector.h"
 #include "Containers/Pair.h"
 #include "Containers/Exception.h"
+#include "Containers/String.h"
+#include "Containers/StringView.h"
 #include "Containers/StringHash.h"
 
 #include <iostream>
 
 
 namespace cave {
+    // Specialize it to let HashMap<K, V>::find/at/count take a Q without
+    // building a K first. std::hash<Q> must give the same hash as std::hash<K>
+    // for equal keys, and K == Q must work.
+    template <typename K, typename Q>
+    struct IsHeterogeneousKey : std::false_type {};
+
+    // Ex: looking up a HashMap<String, V> with a StringView doesn't allocate.
+    template <>
+    struct IsHeterogeneousKey<cave::String, cave::StringView> : std::true_type {};
+
     template <typename K, typename V>
     class HashMap{
+        template <typename Q>
+        using EnableIfLookup = typename std::enable_if<IsHeterogeneousKey<K, Q>::value>::type;
+
     public:
         static constexpr size_t npos = -1;
 
@@ -33,7 +51,7 @@ namespace cave {
         HashMap(HashMap&& other) : m_size(other.m_size), m_buckets(std::move(other.m_buckets)) {
             other.m_size = 0;
         }
-        virtual ~HashMap(){
+        CAVE_CONTAINER_VIRTUAL ~HashMap(){
             clear();
         }
 
@@ -69,29 +87,48 @@ namespace cave {
             Container* next = nullptr;
         };
 
-        struct Iterator {
-            Iterator() {}
-            Iterator(Container* container) : element(container) {}
-            Iterator(const Iterator& other) : element(other.element) {}
+        // Bidirectional iterator, in insertion order (newest first). The +/-
+        // operators are kept for convenience, but they walk the elements one at a
+        // time (O(n)).
+        template <bool IsConst>
+        struct IteratorBase {
+            using iterator_category = std::bidirectional_iterator_tag;
+            using value_type = cave::Pair<K, V>;
+            using difference_type = std::ptrdiff_t;
+            using pointer = typename std::conditional<IsConst, const cave::Pair<K, V>*, cave::Pair<K, V>*>::type;
+            using reference = typename std::conditional<IsConst, const cave::Pair<K, V>&, cave::Pair<K, V>&>::type;
+            using ContainerPtr = typename std::conditional<IsConst, const Container*, Container*>::type;
+
+            IteratorBase() : element(nullptr) {}
+            IteratorBase(ContainerPtr container) : element(container) {}
+            IteratorBase(const IteratorBase& other) : element(other.element) {}
+            // Iterator -> ConstIterator
+            template <bool C = IsConst, typename = typename std::enable_if<C>::type>
+            IteratorBase(const IteratorBase<false>& other) : element(other.element) {}
+
+            IteratorBase& operator=(const IteratorBase& other) {
+                element = other.element;
+                return *this;
+            }
 
-            cave::Pair<K, V>& operator*() {
+            reference operator*() const {
                 // Should I do something if element is null? Perhaps throw an exception...?
                 return element->value;
             }
-            cave::Pair<K, V>* operator->() const {
+            pointer operator->() const {
                 if (element){
                     return &(element->value);
                 }
                 return nullptr;
             }
 
-            Iterator& operator++() {
+            IteratorBase& operator++() {
                 if (element){
                     element = element->next;
                 }
                 return *this;
             }
-            Iterator& operator--() {
+            IteratorBase& operator--() {
                 if (element){
                     element = element->previous;
                 }
@@ -100,74 +137,70 @@ namespace cave {
 
             //--
 
-            Iterator operator+(int i) const {
-                Iterator copy(*this);
+            IteratorBase operator+(int i) const {
+                IteratorBase copy(*this);
                 for (int j = 0; j < i; j++) {
                     copy++;
                 }
                 return copy;
             }
-            Iterator operator-(int i) const {
-                Iterator copy(*this);
+            IteratorBase operator-(int i) const {
+                IteratorBase copy(*this);
                 for (int j = 0; j < i; j++) {
                     copy--;
                 }
                 return copy;
             }
-            Iterator& operator+=(int i) {
+            IteratorBase& operator+=(int i) {
                 for (int j = 0; j < i; j++) {
                     (*this)++;
                 }
                 return *this;
             }
 
-            Iterator& operator-=(int i) {
+            IteratorBase& operator-=(int i) {
                 for (int j = 0; j < i; j++) {
                     (*this)--;
                 }
                 return *this;
             }
 
-            Iterator operator++(int) {
-                Iterator copy(*this);
+            IteratorBase operator++(int) {
+                IteratorBase copy(*this);
                 ++(*this);
                 return copy;
             }
-            Iterator operator--(int) {
-                Iterator copy(*this);
+            IteratorBase operator--(int) {
+                IteratorBase copy(*this);
                 --(*this);
                 return copy;
             }
 
-            bool operator==(const Iterator& other) const {
-                if (element && other.element){
-                    return *element == *other.element;
-                }
-                else if (element == nullptr && other.element == nullptr){
-                    return true;
-                }
-                return false;
+            // The keys are unique, so comparing the containers addresses is enough.
+            friend bool operator==(const IteratorBase& lIter, const IteratorBase& rIter) {
+                return lIter.element == rIter.element;
             }
-
-            bool operator!=(const Iterator& other) const {
-                return !(*this == other);
+            friend bool operator!=(const IteratorBase& lIter, const IteratorBase& rIter) {
+                return lIter.element != rIter.element;
             }
 
-            Container* element;
+            ContainerPtr element;
         };
+        using Iterator = IteratorBase<false>;
+        using ConstIterator = IteratorBase<true>;
 
         Iterator begin() {
             return Iterator(m_firstContainer);
         }
-        const Iterator begin() const {
-            return Iterator(m_firstContainer);
+        ConstIterator begin() const {
+            return ConstIterator(m_firstContainer);
         }
 
         Iterator end() {
             return Iterator(nullptr);
         }
-        const Iterator end() const {
-            return Iterator(nullptr);
+        ConstIterator end() const {
+            return ConstIterator(nullptr);
         }
 
         Iterator find(const K& key){
@@ -181,17 +214,47 @@ namespace cave {
             return end();
         }
 
-        const Iterator find(const K& key) const {
+        ConstIterator find(const K& key) const {
             const size_t hs = bucket(key);
 
             for (auto& e : m_buckets[hs]){
                 if (e.value.first == key) {
-                    return Iterator(&e);
+                    return ConstIterator(&e);
                 }
             }
             return end();
         }        
 
+        // Heterogeneous lookups (see IsHeterogeneousKey):
+        template <typename Q, typename = EnableIfLookup<Q>>
+        Iterator find(const Q& key){
+            return Iterator(findContainer(key));
+        }
+        template <typename Q, typename = EnableIfLookup<Q>>
+        ConstIterator find(const Q& key) const {
+            return ConstIterator(const_cast<HashMap*>(this)->findContainer(key));
+        }
+        template <typename Q, typename = EnableIfLookup<Q>>
+        V& at(const Q& key){
+            Container* container = findContainer(key);
+            if (container == nullptr){
+                throw cave::OutOfRangeException();
+            }
+            return container->value.second;
+        }
+        template <typename Q, typename = EnableIfLookup<Q>>
+        const V& at(const Q& key) const {
+            return const_cast<HashMap*>(this)->at(key);
+        }
+        template <typename Q, typename = EnableIfLookup<Q>>
+        size_t count(const Q& key) const {
+            return const_cast<HashMap*>(this)->findContainer(key) ? 1 : 0;
+        }
+        template <typename Q, typename = EnableIfLookup<Q>>
+        bool exists(const Q& key) const {
+            return count(key) == 1;
+        }
+
         void insert(const cave::Pair<K, V>& pair){
             const size_t hs = bucket(pair.first);
             m_buckets[hs].emplaceBack(pair);
@@ -220,7 +283,7 @@ namespace cave {
 
             updateNewContainerForIteration(hs);
         }
-        void erase(const Iterator& iter){
+        void erase(const ConstIterator& iter){
             // TODO: Optimize this and add unit tests. I've added this like 
             // that just to make it compatible with std...
             erase(iter.element->value.first);
@@ -349,6 +412,17 @@ namespace cave {
         }
 
     private:    
+        template <typename Q>
+        Container* findContainer(const Q& key) {
+            const size_t hs = std::hash<Q>{}(key) % bucketCount();
+            for (auto& e : m_buckets[hs]){
+                if (e.value.first == key) {
+                    return &e;
+                }
+            }
+            return nullptr;
+        }
+
         void updateNewContainerForIteration(size_t hs) {
             auto& back = m_buckets[hs].back();
             back.next = m_firstContainer;
@@ -0,0 +1,64 @@
+#ifndef CAVE_STD_INDEX_ITERATOR_H
+#define CAVE_STD_INDEX_ITERATOR_H
+
+#include <cstddef> // size_t, std::ptrdiff_t
+#include <utility> // std::declval
+#include <iterator> // std::random_access_iterator_tag
+#include <type_traits>
+
+
+namespace cave {
+    // Random access iterator for the containers that aren't contiguous but can
+    // be indexed (Deque, StableVector...): it keeps the container and a position
+    // and goes through the container's operator[] to reach the element.
+    // Owner is the (non const) container type.
+    // Ex:  using Iterator = IndexIterator<Deque, false>;
+    //      using ConstIterator = IndexIterator<Deque, true>;
+    template <typename Owner, bool IsConst>
+    struct IndexIterator {
+        using OwnerType = typename std::conditional<IsConst, const Owner, Owner>::type;
+
+        using iterator_category = std::random_access_iterator_tag;
+        using reference = decltype(std::declval<OwnerType&>()[size_t(0)]);
+        using value_type = typename std::remove_const<typename std::remove_reference<reference>::type>::type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = typename std::remove_reference<reference>::type*;
+
+        IndexIterator() : m_owner(nullptr), m_pos(0) {}
+        IndexIterator(OwnerType* owner, size_t pos) : m_owner(owner), m_pos(pos) {}
+        // Iterator -> ConstIterator
+        template <bool C = IsConst, typename = typename std::enable_if<C>::type>
+        IndexIterator(const IndexIterator<Owner, false>& other) : m_owner(other.m_owner), m_pos(other.m_pos) {}
+
+        reference operator*() const { return (*m_owner)[m_pos]; }
+        pointer operator->() const { return &(*m_owner)[m_pos]; }
+        reference operator[](difference_type i) const { return (*m_owner)[m_pos + i]; }
+
+        IndexIterator& operator++() { ++m_pos; return *this; }
+        IndexIterator& operator--() { --m_pos; return *this; }
+        IndexIterator operator++(int) { IndexIterator copy(*this); ++m_pos; return copy; }
+        IndexIterator operator--(int) { IndexIterator copy(*this); --m_pos; return copy; }
+
+        IndexIterator& operator+=(difference_type i) { m_pos += i; return *this; }
+        IndexIterator& operator-=(difference_type i) { m_pos -= i; return *this; }
+        IndexIterator operator+(difference_type i) const { return IndexIterator(m_owner, m_pos + i); }
+        IndexIterator operator-(difference_type i) const { return IndexIterator(m_owner, m_pos - i); }
+        friend IndexIterator operator+(difference_type i, const IndexIterator& it) { return it + i; }
+        friend difference_type operator-(const IndexIterator& lIter, const IndexIterator& rIter) {
+            return difference_type(lIter.m_pos) - difference_type(rIter.m_pos);
+        }
+
+        // Friends, so an Iterator can be compared with a ConstIterator.
+        friend bool operator==(const IndexIterator& lIter, const IndexIterator& rIter) { return lIter.m_pos == rIter.m_pos; }
+        friend bool operator!=(const IndexIterator& lIter, const IndexIterator& rIter) { return lIter.m_pos != rIter.m_pos; }
+        friend bool operator<(const IndexIterator& lIter, const IndexIterator& rIter)  { return lIter.m_pos < rIter.m_pos; }
+        friend bool operator>(const IndexIterator& lIter, const IndexIterator& rIter)  { return lIter.m_pos > rIter.m_pos; }
+        friend bool operator<=(const IndexIterator& lIter, const IndexIterator& rIter) { return lIter.m_pos <= rIter.m_pos; }
+        friend bool operator>=(const IndexIterator& lIter, const IndexIterator& rIter) { return lIter.m_pos >= rIter.m_pos; }
+
+        OwnerType* m_owner;
+        size_t m_pos;
+    };
+}
+
+#endif // !CAVE_STD_INDEX_ITERATOR_H
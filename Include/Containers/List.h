@@ -1,12 +1,15 @@
 #ifndef CAVE_STD_LIST_H
 #define CAVE_STD_LIST_H
 
-#include <cstddef> // size_t
+#include <cstddef> // size_t, std::ptrdiff_t
+#include <iterator> // std::bidirectional_iterator_tag
+#include <type_traits> // std::conditional
 #include <utility> // std::move, std::forward
 #include <cstdlib> // malloc, free
 #include <cstring> // memset
 #include <initializer_list>
 
+#include "Containers/Config.h"
 #include "Containers/Exception.h"
 
 
@@ -32,47 +35,69 @@ namespace cave {
             other.m_last = nullptr;
             other.m_size = 0;
         }
-        virtual ~List(){
+        CAVE_CONTAINER_VIRTUAL ~List(){
             clear();
         }
 
-        struct Iterator {
-            Iterator(const Iterator& other) : current(other.current), endPrev(other.endPrev) {}
-            Iterator(Node* current, Node* end=nullptr) : current(current), endPrev(end) {}
+        // Bidirectional iterator. The +/- operators are kept for convenience,
+        // but they walk the list one node at a time (O(n)).
+        template <bool IsConst>
+        struct IteratorBase {
+            using iterator_category = std::bidirectional_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = typename std::conditional<IsConst, const T*, T*>::type;
+            using reference = typename std::conditional<IsConst, const T&, T&>::type;
+
+            IteratorBase() : current(nullptr), endPrev(nullptr) {}
+            IteratorBase(const IteratorBase& other) : current(other.current), endPrev(other.endPrev) {}
+            IteratorBase(Node* current, Node* end=nullptr) : current(current), endPrev(end) {}
+            // Iterator -> ConstIterator
+            template <bool C = IsConst, typename = typename std::enable_if<C>::type>
+            IteratorBase(const IteratorBase<false>& other) : current(other.current), endPrev(other.endPrev) {}
+
+            IteratorBase& operator=(const IteratorBase& other) {
+                current = other.current;
+                endPrev = other.endPrev;
+                return *this;
+            }
 
-            T& operator*() {
+            reference operator*() const {
                 return current->value;
             }
+            pointer operator->() const {
+                return &current->value;
+            }
 
-            Iterator operator+(int i) const {
-                Iterator copy(*this);
+            IteratorBase operator+(int i) const {
+                IteratorBase copy(*this);
                 for (int j = 0; j < i; j++) {
                     copy++;
                 }
                 return copy;
             }
-            Iterator operator-(int i) const {
-                Iterator copy(*this);
+            IteratorBase operator-(int i) const {
+                IteratorBase copy(*this);
                 for (int j = 0; j < i; j++) {
                     copy--;
                 }
                 return copy;
             }
-            Iterator& operator+=(int i) {
+            IteratorBase& operator+=(int i) {
                 for (int j = 0; j < i; j++) {
                     (*this)++;
                 }
                 return *this;
             }
 
-            Iterator& operator-=(int i) {
+            IteratorBase& operator-=(int i) {
                 for (int j = 0; j < i; j++) {
                     (*this)--;
                 }
                 return *this;
             }
 
-            Iterator& operator++() {
+            IteratorBase& operator++() {
                 if (current->next == nullptr){
                     endPrev = current;
                 }
@@ -80,13 +105,13 @@ namespace cave {
                 return *this;
             }
 
-            Iterator operator++(int) {
-                Iterator copy(*this);
+            IteratorBase operator++(int) {
+                IteratorBase copy(*this);
                 ++(*this);
                 return copy;
             }
 
-            Iterator& operator--() {
+            IteratorBase& operator--() {
                 if (current){
                     current = current->prev;
                 }
@@ -96,36 +121,38 @@ namespace cave {
                 return *this;
             }
 
-            Iterator operator--(int) {
-                Iterator copy(*this);
+            IteratorBase operator--(int) {
+                IteratorBase copy(*this);
                 --(*this);
                 return copy;
             }
 
-            bool operator==(const Iterator& other) const {
-                return current == other.current;
+            friend bool operator==(const IteratorBase& lIter, const IteratorBase& rIter) {
+                return lIter.current == rIter.current;
             }
 
-            bool operator!=(const Iterator& other) const {
-                return !(*this == other);
+            friend bool operator!=(const IteratorBase& lIter, const IteratorBase& rIter) {
+                return lIter.current != rIter.current;
             }
 
             Node* current;
             Node* endPrev;
         };
+        using Iterator = IteratorBase<false>;
+        using ConstIterator = IteratorBase<true>;
 
         Iterator begin() {
             return Iterator(m_first);
         }
-        const Iterator begin() const {
-            return Iterator(m_first);
+        ConstIterator begin() const {
+            return ConstIterator(m_first);
         }
 
         Iterator end() {
             return Iterator(nullptr, m_last);
         }
-        const Iterator end() const {
-            return Iterator(nullptr, m_last);
+        ConstIterator end() const {
+            return ConstIterator(nullptr, m_last);
         }
 
         T&       front() {
@@ -141,7 +168,7 @@ namespace cave {
             return m_last->value;
         }
 
-        T operator[](size_t pos) const {
+        const T& operator[](size_t pos) const {
             return getNodeInternal(pos)->value;
         }
         T& operator[](size_t pos) {
@@ -235,7 +262,7 @@ namespace cave {
             Node* node = getNodeInternal(pos);
             removeNodeInternal(node);
         }
-        void erase(Iterator pos){
+        void erase(ConstIterator pos){
             Node* node = pos.current;
             removeNodeInternal(node);
         }
@@ -256,10 +283,10 @@ namespace cave {
         void insert(size_t pos, T&& value) {
             addToPosInternal(pos, new Node(value));
         }
-        void insert(Iterator pos, const T& value) {
+        void insert(ConstIterator pos, const T& value) {
             addToPosInternal(pos.current, new Node(value));
         }
-        void insert(Iterator pos, T&& value) {
+        void insert(ConstIterator pos, T&& value) {
             addToPosInternal(pos.current, new Node(value));
         }
 
@@ -0,0 +1,51 @@
+#ifndef CAVE_STD_MAPPED_FILE_H
+#define CAVE_STD_MAPPED_FILE_H
+
+#include <cstddef> // size_t
+
+
+namespace cave {
+    // Read only memory mapping of a whole file (mmap on posix, MapViewOfFile on
+    // Windows). The pages are only loaded when touched, nothing is copied.
+    class MappedFile {
+    public:
+        // Hints on how the mapping will be accessed (madvise). They don't change
+        // the behavior, only how the OS reads the file ahead.
+        enum class Access {
+            Normal,
+            Sequential,
+            Random,
+            WillNeed,
+        };
+
+        MappedFile();
+        MappedFile(const MappedFile&) = delete;
+        MappedFile(MappedFile&& other) noexcept;
+        virtual ~MappedFile();
+
+        MappedFile& operator=(const MappedFile&) = delete;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+
+        // Returns false if the file couldn't be opened or mapped. Empty files
+        // are valid: data() will be nullptr and size() zero.
+        bool open(const char* path, Access hint = Access::Normal);
+        void close();
+        bool isOpen() const;
+
+        void advise(Access hint);
+
+        const void* data() const;
+        size_t size() const;
+
+    private:
+        void* m_data;
+        size_t m_size;
+        bool m_open;
+#ifdef _WIN32
+        void* m_file;
+        void* m_mapping;
+#endif
+    };
+}
+
+#endif // !CAVE_STD_MAPPED_FILE_H
@@ -0,0 +1,137 @@
+#ifndef CAVE_STD_MAPPED_VECTOR_H
+#define CAVE_STD_MAPPED_VECTOR_H
+
+#include <cstddef> // size_t
+#include <cstring> // memcpy
+#include <utility> // std::move
+#include <type_traits>
+
+#include "Containers/Config.h"
+#include "Containers/MappedFile.h"
+#include "Containers/Vector.h"
+#include "Containers/Simd.h"
+#include "Containers/Exception.h"
+
+
+namespace cave {
+    // Read only Vector-like view over a file of T's that is memory mapped
+    // instead of loaded: opening it costs the same for a 1 KB or a 1 GB file,
+    // and the pages are read from disk on demand. The file must have been
+    // written as a raw array of T (same layout, same endianness).
+    template <typename T>
+    class MappedVector {
+    public:
+        static_assert(std::is_trivially_copyable<T>::value, "MappedVector requires a trivially copyable T.");
+
+        static constexpr size_t npos = -1;
+        using Access = MappedFile::Access;
+        using Iterator = const T*;
+
+        MappedVector() {}
+        MappedVector(MappedVector&& other) noexcept : m_file(std::move(other.m_file)) {}
+        CAVE_CONTAINER_VIRTUAL ~MappedVector() {}
+
+        MappedVector& operator=(MappedVector&& other) noexcept {
+            m_file = std::move(other.m_file);
+            return *this;
+        }
+
+        // Returns false if the file can't be mapped or if its size isn't a
+        // multiple of sizeof(T).
+        bool open(const char* path, Access hint = Access::Normal){
+            if (!m_file.open(path, hint)){
+                return false;
+            }
+            if (m_file.size() % sizeof(T) != 0){
+                m_file.close();
+                return false;
+            }
+            return true;
+        }
+        void close(){
+            m_file.close();
+        }
+        bool isOpen() const {
+            return m_file.isOpen();
+        }
+
+        // Tells the OS how the data is about to be accessed (see MappedFile::Access).
+        void advise(Access hint){
+            m_file.advise(hint);
+        }
+
+        Iterator begin() const {
+            return data();
+        }
+        Iterator end() const {
+            return data() + size();
+        }
+
+        const T& front() const {
+            return data()[0];
+        }
+        const T& back() const {
+            return data()[size() - 1];
+        }
+
+        const T& operator[](size_t pos) const {
+            return data()[pos];
+        }
+        const T& at(size_t pos) const {
+            if (pos >= size()){
+                throw cave::OutOfRangeException(pos);
+            }
+            return data()[pos];
+        }
+
+        size_t findID(const T& object) const {
+            if constexpr (simd::IsAccelerated<T>::value){
+                const size_t id = simd::find(data(), size(), object);
+                return id < size() ? id : npos;
+            }
+            else {
+                for (size_t i=0; i<size(); i++){
+                    if (data()[i] == object){
+                        return i;
+                    }
+                }
+                return npos;
+            }
+        }
+        Iterator find(const T& element) const {
+            const size_t id = findID(element);
+            if (id == npos){
+                return end();
+            }
+            return data() + id;
+        }
+        bool contains(const T& element) const {
+            return findID(element) != npos;
+        }
+
+        const T* data() const noexcept {
+            return (const T*)m_file.data();
+        }
+        size_t size() const {
+            return m_file.size() / sizeof(T);
+        }
+        bool empty() const {
+            return size() == 0;
+        }
+
+        // Copies everything into a regular (writable) Vector.
+        Vector<T> toVector() const {
+            Vector<T> out;
+            out.resizeUninitialized(size());
+            if (size() > 0){
+                memcpy((void*)out.data(), (const void*)data(), size() * sizeof(T));
+            }
+            return out;
+        }
+
+    private:
+        MappedFile m_file;
+    };
+}
+
+#endif // !CAVE_STD_MAPPED_VECTOR_H
@@ -0,0 +1,108 @@
+/*
+Low level helpers shared by the containers that manage their own raw memory
+(Vector, SoAVector...): the growth policy, moving objects between buffers and
+aligned allocations.
+*/
+
+#ifndef CAVE_STD_MEMORY_H
+#define CAVE_STD_MEMORY_H
+
+#include <cstddef> // size_t
+#include <cstdint> // uintptr_t
+#include <cstdlib> // malloc, free
+#include <cstring> // memcpy, memmove
+#include <utility> // std::move
+#include <type_traits>
+
+
+namespace cave {
+    namespace memory {
+        // How many slots to allocate in order to fit newSize elements: the next
+        // power of two, but never less than minSlots.
+        inline size_t growCapacity(size_t newSize, size_t minSlots){
+            if (newSize < minSlots){
+                return minSlots;
+            }
+            size_t v = newSize - 1;
+            v |= v >> 1;  v |= v >> 2;
+            v |= v >> 4;  v |= v >> 8;
+            v |= v >> 16;
+            if (sizeof(size_t) > 4){
+                v |= v >> 16 >> 16;
+            }
+            return v + 1;
+        }
+
+        // Moves count objects from src to the (uninitialized) dst, leaving src
+        // uninitialized. Trivially copyable types are simply memcpy'ed.
+        template <typename T>
+        void relocate(T* dst, T* src, size_t count){
+            if (count == 0){
+                return;
+            }
+            if constexpr (std::is_trivially_copyable<T>::value){
+                memcpy((void*)dst, (const void*)src, count * sizeof(T));
+            }
+            else {
+                for (size_t i=0; i<count; i++){
+                    new(&dst[i]) T(std::move(src[i]));
+                    src[i].~T();
+                }
+            }
+        }
+
+        // Moves src into an already constructed dst. Types that can't be move
+        // assigned are destroyed and move constructed in place instead.
+        template <typename T>
+        void moveSlot(T& dst, T& src){
+            if constexpr (std::is_move_assignable<T>::value){
+                dst = std::move(src);
+            }
+            else {
+                dst.~T();
+                new(&dst) T(std::move(src));
+            }
+        }
+
+        // Removes the [first, last) range from an array of size objects, shifting
+        // the tail down and destroying what is left at the end. It doesn't check
+        // the bounds. Returns the new size.
+        template <typename T>
+        size_t eraseRange(T* data, size_t size, size_t first, size_t last){
+            if constexpr (std::is_trivially_copyable<T>::value){
+                memmove((void*)(data + first), (const void*)(data + last), (size - last) * sizeof(T));
+            }
+            else {
+                for (size_t i = last; i < size; i++){
+                    moveSlot(data[first + i - last], data[i]);
+                }
+            }
+
+            const size_t newSize = size - (last - first);
+            for (size_t i = newSize; i < size; i++){
+                data[i].~T();
+            }
+            return newSize;
+        }
+
+        // Allocates size bytes aligned to alignment (a power of two). The memory
+        // MUST be released with alignedFree.
+        inline void* alignedAlloc(size_t size, size_t alignment){
+            // Storing the original pointer right before the aligned block:
+            void* raw = malloc(size + alignment + sizeof(void*));
+            if (raw == nullptr){
+                return nullptr;
+            }
+            uintptr_t aligned = (uintptr_t(raw) + sizeof(void*) + alignment - 1) & ~uintptr_t(alignment - 1);
+            ((void**)aligned)[-1] = raw;
+            return (void*)aligned;
+        }
+        inline void alignedFree(void* ptr){
+            if (ptr){
+                free(((void**)ptr)[-1]);
+            }
+        }
+    }
+}
+
+#endif // !CAVE_STD_MEMORY_H
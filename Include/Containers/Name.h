@@ -0,0 +1,105 @@
+#ifndef CAVE_STD_NAME_H
+#define CAVE_STD_NAME_H
+
+#include <cstddef> // size_t
+#include <cstdint> // uint32_t
+#include <ostream> // operator<<
+#include <functional> // std::hash
+
+#include "Containers/String.h"
+#include "Containers/StringView.h"
+
+
+namespace cave {
+    // Interned string: every distinct text is stored only once in a global (and
+    // thread safe) table, so a Name is just a pointer to it. Comparing two Names
+    // is a pointer compare and hashing them is free (it's the id), which makes
+    // them perfect for identifiers that are compared all the time (component
+    // names, bones, shader parameters...).
+    // The table is arena allocated and never freed (not even at exit), so the
+    // c_str() of a Name is always valid, even in the destructors of other
+    // statics. Don't intern unbounded user data!
+    // Ex:  static const cave::Name s_albedo("albedo");
+    class Name {
+    public:
+        // The empty Name (id zero). It doesn't touch the table.
+        constexpr Name() : m_entry(nullptr) {}
+        // These intern the string (adding it to the table if it's new), which
+        // takes a lock. Construct the Names once and keep them around.
+        explicit Name(const char* str);
+        explicit Name(StringView str);
+        explicit Name(const String& str);
+
+        // Returns the Name if the string is already interned or the empty Name
+        // otherwise (never adds anything to the table).
+        static Name find(StringView str);
+
+        // Amount of distinct (non empty) strings interned so far.
+        static size_t tableSize();
+
+        // Unique per string (and stable for the whole run), zero for the empty Name.
+        // Notice that it depends on the interning order, so don't serialize it.
+        uint32_t id() const {
+            return m_entry ? m_entry->id : 0;
+        }
+        // Same as std::hash<cave::StringView> for the same chars.
+        size_t stringHash() const;
+
+        const char* c_str() const {
+            return m_entry ? reinterpret_cast<const char*>(m_entry + 1) : "";
+        }
+        size_t size() const {
+            return m_entry ? m_entry->size : 0;
+        }
+        bool empty() const {
+            return m_entry == nullptr;
+        }
+
+        StringView view() const {
+            return StringView(c_str(), size());
+        }
+        operator StringView() const {
+            return view();
+        }
+        String toString() const {
+            return String(view());
+        }
+
+        friend bool operator==(Name lName, Name rName) { return lName.m_entry == rName.m_entry; }
+        friend bool operator!=(Name lName, Name rName) { return lName.m_entry != rName.m_entry; }
+        // Compares the chars (without interning anything).
+        friend bool operator==(Name lName, StringView rStr) { return lName.view() == rStr; }
+        friend bool operator!=(Name lName, StringView rStr) { return lName.view() != rStr; }
+        // Orders by id (NOT alphabetically), it's only meant for sorted containers.
+        // Use view().compare() for the alphabetical order.
+        friend bool operator<(Name lName, Name rName) { return lName.id() < rName.id(); }
+
+        friend auto operator<<(std::ostream& os, Name name) -> std::ostream& {
+            return os << name.view();
+        }
+
+        // How each string is stored in the table (the chars and a null
+        // terminator come right after it).
+        struct Entry {
+            size_t hash;
+            uint32_t id;
+            uint32_t size;
+        };
+
+    private:
+        explicit Name(const Entry* entry) : m_entry(entry) {}
+
+        const Entry* m_entry;
+    };
+}
+
+namespace std {
+    template<>
+    struct hash<cave::Name> {
+        size_t operator()(cave::Name name) const {
+            return name.id();
+        }
+    };
+}
+
+#endif // !CAVE_STD_NAME_H
@@ -4,6 +4,8 @@
 #include <cstddef> // size_t
 #include <utility> // std::move, std::forward
 
+#include "Containers/Config.h"
+
 
 namespace cave {
     template <typename T1, typename T2>
@@ -20,7 +22,7 @@ namespace cave {
         }
         Pair(const T1& first, const T2& second) : first(first), second(second) {}
         Pair(T1&& first, T2&& second) : first(std::move(first)), second(std::move(second)) {}
-        virtual ~Pair() {}
+        CAVE_CONTAINER_VIRTUAL ~Pair() {}
 
         Pair& operator=(const Pair& other) {
             first = other.first;
@@ -0,0 +1,216 @@
+#ifndef CAVE_STD_SHARED_STRING_H
+#define CAVE_STD_SHARED_STRING_H
+
+#include <atomic>
+#include <cstddef> // size_t
+#include <cstdlib> // malloc, free
+#include <cstring> // memcpy
+#include <new>     // placement new
+#include <ostream> // operator<<
+#include <functional> // std::hash
+#include <string_view>
+#include <type_traits>
+
+#include "Containers/String.h"
+#include "Containers/StringView.h"
+#include "Containers/Exception.h"
+
+
+namespace cave {
+    // Immutable string whose chars (and hash) are shared by all of its copies.
+    // Copying it only bumps a reference count, and the hash is computed once
+    // (when created), so it's meant for the strings that are built once and then
+    // copied and hashed all the time: map keys, event names, asset ids...
+    // Copying a HashMap<SharedString, V> doesn't copy a single char.
+    // Atomic picks how the count is kept: SharedString (atomic) can be copied
+    // and released from any thread, LocalSharedString (a plain counter) is a
+    // bit cheaper but its copies must never leave the thread.
+    // Ex:  cave::SharedString id("textures/rock_albedo.png");
+    //      m_textures[id] = texture; // No copy of the chars.
+    template <bool Atomic>
+    class BasicSharedString {
+    public:
+        // The empty string (it doesn't allocate).
+        BasicSharedString() noexcept : m_rep(nullptr) {}
+        // These allocate (once) and copy the chars.
+        BasicSharedString(const char* str) : m_rep(create(StringView(str))) {}
+        explicit BasicSharedString(StringView str) : m_rep(create(str)) {}
+        explicit BasicSharedString(const String& str) : m_rep(create(str.view())) {}
+
+        BasicSharedString(const BasicSharedString& other) noexcept : m_rep(other.m_rep) {
+            retain();
+        }
+        BasicSharedString(BasicSharedString&& other) noexcept : m_rep(other.m_rep) {
+            other.m_rep = nullptr;
+        }
+        ~BasicSharedString(){
+            release();
+        }
+
+        BasicSharedString& operator=(const BasicSharedString& other) noexcept {
+            if (m_rep != other.m_rep){
+                release();
+                m_rep = other.m_rep;
+                retain();
+            }
+            return *this;
+        }
+        BasicSharedString& operator=(BasicSharedString&& other) noexcept {
+            if (this != &other){
+                release();
+                m_rep = other.m_rep;
+                other.m_rep = nullptr;
+            }
+            return *this;
+        }
+
+        const char* c_str() const {
+            return m_rep ? reinterpret_cast<const char*>(m_rep + 1) : "";
+        }
+        const char* data() const {
+            return c_str();
+        }
+        size_t size() const {
+            return m_rep ? m_rep->size : 0;
+        }
+        bool empty() const {
+            return m_rep == nullptr;
+        }
+        char operator[](size_t index) const {
+            return c_str()[index];
+        }
+        char at(size_t index) const {
+            if (index >= size()){
+                throw cave::OutOfRangeException(index);
+            }
+            return c_str()[index];
+        }
+
+        // The cached hash: the same as std::hash<cave::StringView> (and String)
+        // for the same chars.
+        size_t hash() const {
+            return m_rep ? m_rep->hash : emptyHash();
+        }
+        // How many SharedStrings share these chars (zero for the empty string).
+        size_t useCount() const {
+            return m_rep ? size_t(m_rep->refs) : 0;
+        }
+
+        StringView view() const {
+            return StringView(c_str(), size());
+        }
+        operator StringView() const {
+            return view();
+        }
+        // A (mutable) copy of the chars.
+        String toString() const {
+            return String(view());
+        }
+
+        // Copies sharing the chars are equal right away, and different hashes
+        // mean different strings, so most compares never touch the chars.
+        friend bool operator==(const BasicSharedString& lStr, const BasicSharedString& rStr) {
+            return lStr.m_rep == rStr.m_rep ||
+                (lStr.hash() == rStr.hash() && lStr.view() == rStr.view());
+        }
+        friend bool operator!=(const BasicSharedString& lStr, const BasicSharedString& rStr) {
+            return !(lStr == rStr);
+        }
+        friend bool operator==(const BasicSharedString& lStr, StringView rStr) { return lStr.view() == rStr; }
+        friend bool operator!=(const BasicSharedString& lStr, StringView rStr) { return lStr.view() != rStr; }
+        friend bool operator==(StringView lStr, const BasicSharedString& rStr) { return lStr == rStr.view(); }
+        friend bool operator!=(StringView lStr, const BasicSharedString& rStr) { return lStr != rStr.view(); }
+        // (An exact match, or C++20 finds it ambiguous with String's reversed operator==.)
+        friend bool operator==(const BasicSharedString& lStr, const String& rStr) { return lStr.view() == rStr.view(); }
+        friend bool operator!=(const BasicSharedString& lStr, const String& rStr) { return lStr.view() != rStr.view(); }
+        friend bool operator==(const BasicSharedString& lStr, const char* rStr) { return lStr.view() == StringView(rStr); }
+        friend bool operator!=(const BasicSharedString& lStr, const char* rStr) { return lStr.view() != StringView(rStr); }
+        // Alphabetical order.
+        friend bool operator<(const BasicSharedString& lStr, const BasicSharedString& rStr) {
+            return lStr.view().compare(rStr.view()) < 0;
+        }
+
+        friend auto operator<<(std::ostream& os, const BasicSharedString& str) -> std::ostream& {
+            return os << str.view();
+        }
+
+    private:
+        using RefCount = typename std::conditional<Atomic, std::atomic<size_t>, size_t>::type;
+
+        // The chars (and a null terminator) come right after it, in the same block.
+        struct Rep {
+            RefCount refs;
+            size_t hash;
+            size_t size;
+        };
+
+        static size_t emptyHash() {
+            return std::hash<std::string_view>()(std::string_view());
+        }
+
+        static Rep* create(StringView str){
+            if (str.empty()){
+                return nullptr;
+            }
+            Rep* rep = new(malloc(sizeof(Rep) + str.size() + 1)) Rep();
+            rep->refs = 1;
+            rep->hash = std::hash<std::string_view>()(std::string_view(str.data(), str.size()));
+            rep->size = str.size();
+            char* chars = reinterpret_cast<char*>(rep + 1);
+            memcpy(chars, str.data(), str.size());
+            chars[str.size()] = '\0';
+            return rep;
+        }
+
+        void retain(){
+            if (m_rep){
+                if constexpr (Atomic){
+                    m_rep->refs.fetch_add(1, std::memory_order_relaxed);
+                }
+                else {
+                    m_rep->refs++;
+                }
+            }
+        }
+        void release(){
+            if (m_rep == nullptr){
+                return;
+            }
+            bool last = false;
+            if constexpr (Atomic){
+                last = m_rep->refs.fetch_sub(1, std::memory_order_acq_rel) == 1;
+            }
+            else {
+                last = --m_rep->refs == 0;
+            }
+            if (last){
+                m_rep->~Rep();
+                free(m_rep);
+            }
+            m_rep = nullptr;
+        }
+
+        Rep* m_rep;
+    };
+
+    using SharedString = BasicSharedString<true>;
+    using LocalSharedString = BasicSharedString<false>;
+
+    // Looking up a HashMap<SharedString, V> with a StringView doesn't build a
+    // SharedString (see HashMap.h).
+    template <typename K, typename Q>
+    struct IsHeterogeneousKey;
+    template <bool Atomic>
+    struct IsHeterogeneousKey<BasicSharedString<Atomic>, StringView> : std::true_type {};
+}
+
+namespace std {
+    template<bool Atomic>
+    struct hash<cave::BasicSharedString<Atomic>> {
+        size_t operator()(const cave::BasicSharedString<Atomic>& str) const {
+            return str.hash();
+        }
+    };
+}
+
+#endif // !CAVE_STD_SHARED_STRING_H
@@ -0,0 +1,428 @@
+/*
+Small set of SIMD kernels used by the containers to scan arrays of numbers
+(Vector::find, count, minMax...). The best instruction set available at compile
+time is chosen automatically (AVX2, then SSE2), and everything else falls back
+to plain scalar loops. You usually don't need to include this file directly.
+*/
+
+#ifndef CAVE_STD_SIMD_H
+#define CAVE_STD_SIMD_H
+
+#include <cstddef> // size_t
+#include <cstdint> // uint32_t
+#include <cstring> // memcpy
+#include <type_traits>
+
+#if defined(__AVX2__)
+    #define CAVE_SIMD_AVX2 1
+    #define CAVE_SIMD_SSE2 1
+    #include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define CAVE_SIMD_SSE2 1
+    #include <emmintrin.h>
+    #if defined(__SSE4_1__)
+        #include <smmintrin.h>
+    #endif
+#endif
+
+#ifdef _MSC_VER
+    #include <intrin.h>
+#endif
+
+
+namespace cave {
+    namespace simd {
+        // Types that the SIMD kernels know how to handle.
+        template <typename T>
+        struct IsAccelerated : std::integral_constant<bool,
+            (std::is_integral<T>::value && !std::is_same<T, bool>::value) ||
+            std::is_same<T, float>::value || std::is_same<T, double>::value> {};
+
+        inline unsigned int countTrailingZeros(uint32_t v){
+#ifdef _MSC_VER
+            unsigned long id;
+            _BitScanForward(&id, v);
+            return (unsigned int)id;
+#else
+            return (unsigned int)__builtin_ctz(v);
+#endif
+        }
+        inline unsigned int countTrailingZeros64(uint64_t v){
+#ifdef _MSC_VER
+            unsigned long id;
+            _BitScanForward64(&id, v);
+            return (unsigned int)id;
+#else
+            return (unsigned int)__builtin_ctzll(v);
+#endif
+        }
+        // Index of the highest set bit (v can't be zero).
+        inline unsigned int highestBit(uint32_t v){
+#ifdef _MSC_VER
+            unsigned long id;
+            _BitScanReverse(&id, v);
+            return (unsigned int)id;
+#else
+            return 31u - (unsigned int)__builtin_clz(v);
+#endif
+        }
+        inline unsigned int highestBit64(uint64_t v){
+#ifdef _MSC_VER
+            unsigned long id;
+            _BitScanReverse64(&id, v);
+            return (unsigned int)id;
+#else
+            return 63u - (unsigned int)__builtin_clzll(v);
+#endif
+        }
+        inline unsigned int popCount(uint32_t v){
+#ifdef _MSC_VER
+            return (unsigned int)__popcnt(v);
+#else
+            return (unsigned int)__builtin_popcount(v);
+#endif
+        }
+        inline unsigned int popCount64(uint64_t v){
+#ifdef _MSC_VER
+            return (unsigned int)__popcnt64(v);
+#else
+            return (unsigned int)__builtin_popcountll(v);
+#endif
+        }
+
+        // Hints the CPU to start loading the cache line at addr. It never faults,
+        // so it's fine to prefetch past the end of an array.
+        inline void prefetch(const void* addr){
+#if defined(_MSC_VER) && defined(CAVE_SIMD_SSE2)
+            _mm_prefetch((const char*)addr, _MM_HINT_T0);
+#elif defined(__GNUC__) || defined(__clang__)
+            __builtin_prefetch(addr);
+#else
+            (void)addr;
+#endif
+        }
+
+#if defined(CAVE_SIMD_AVX2)
+        using Register = __m256i;
+        using Mask = uint32_t;
+        static constexpr size_t registerSize = 32;
+
+        template <typename T>
+        inline Register splat(T value){
+            if constexpr (std::is_same<T, float>::value){
+                return _mm256_castps_si256(_mm256_set1_ps(value));
+            }
+            else if constexpr (std::is_same<T, double>::value){
+                return _mm256_castpd_si256(_mm256_set1_pd(value));
+            }
+            else if constexpr (sizeof(T) == 1){ return _mm256_set1_epi8((char)value); }
+            else if constexpr (sizeof(T) == 2){ return _mm256_set1_epi16((short)value); }
+            else if constexpr (sizeof(T) == 4){ return _mm256_set1_epi32((int)value); }
+            else { return _mm256_set1_epi64x((long long)value); }
+        }
+
+        // Compares a register worth of elements against the splatted value and
+        // returns a mask with one bit per BYTE that matched.
+        template <typename T>
+        inline Mask equalMask(const T* ptr, Register value){
+            const Register data = _mm256_loadu_si256((const __m256i*)ptr);
+            if constexpr (std::is_same<T, float>::value){
+                return (Mask)_mm256_movemask_epi8(_mm256_castps_si256(
+                    _mm256_cmp_ps(_mm256_castsi256_ps(data), _mm256_castsi256_ps(value), _CMP_EQ_OQ)));
+            }
+            else if constexpr (std::is_same<T, double>::value){
+                return (Mask)_mm256_movemask_epi8(_mm256_castpd_si256(
+                    _mm256_cmp_pd(_mm256_castsi256_pd(data), _mm256_castsi256_pd(value), _CMP_EQ_OQ)));
+            }
+            else if constexpr (sizeof(T) == 1){ return (Mask)_mm256_movemask_epi8(_mm256_cmpeq_epi8(data, value)); }
+            else if constexpr (sizeof(T) == 2){ return (Mask)_mm256_movemask_epi8(_mm256_cmpeq_epi16(data, value)); }
+            else if constexpr (sizeof(T) == 4){ return (Mask)_mm256_movemask_epi8(_mm256_cmpeq_epi32(data, value)); }
+            else { return (Mask)_mm256_movemask_epi8(_mm256_cmpeq_epi64(data, value)); }
+        }
+#elif defined(CAVE_SIMD_SSE2)
+        using Register = __m128i;
+        using Mask = uint32_t;
+        static constexpr size_t registerSize = 16;
+
+        template <typename T>
+        inline Register splat(T value){
+            if constexpr (std::is_same<T, float>::value){
+                return _mm_castps_si128(_mm_set1_ps(value));
+            }
+            else if constexpr (std::is_same<T, double>::value){
+                return _mm_castpd_si128(_mm_set1_pd(value));
+            }
+            else if constexpr (sizeof(T) == 1){ return _mm_set1_epi8((char)value); }
+            else if constexpr (sizeof(T) == 2){ return _mm_set1_epi16((short)value); }
+            else if constexpr (sizeof(T) == 4){ return _mm_set1_epi32((int)value); }
+            else {
+                long long v;
+                memcpy(&v, &value, sizeof(v));
+                return _mm_set_epi64x(v, v);
+            }
+        }
+
+        template <typename T>
+        inline Mask equalMask(const T* ptr, Register value){
+            const Register data = _mm_loadu_si128((const __m128i*)ptr);
+            if constexpr (std::is_same<T, float>::value){
+                return (Mask)_mm_movemask_epi8(_mm_castps_si128(
+                    _mm_cmpeq_ps(_mm_castsi128_ps(data), _mm_castsi128_ps(value))));
+            }
+            else if constexpr (std::is_same<T, double>::value){
+                return (Mask)_mm_movemask_epi8(_mm_castpd_si128(
+                    _mm_cmpeq_pd(_mm_castsi128_pd(data), _mm_castsi128_pd(value))));
+            }
+            else if constexpr (sizeof(T) == 1){ return (Mask)_mm_movemask_epi8(_mm_cmpeq_epi8(data, value)); }
+            else if constexpr (sizeof(T) == 2){ return (Mask)_mm_movemask_epi8(_mm_cmpeq_epi16(data, value)); }
+            else if constexpr (sizeof(T) == 4){ return (Mask)_mm_movemask_epi8(_mm_cmpeq_epi32(data, value)); }
+            else {
+                // No 64 bits compare in SSE2: both 32 bits halves must match.
+                const Register eq = _mm_cmpeq_epi32(data, value);
+                return (Mask)_mm_movemask_epi8(_mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1))));
+            }
+        }
+#endif
+
+        // Index of the first element equal to value, or n if there is none.
+        template <typename T>
+        size_t find(const T* data, size_t n, T value){
+            size_t i = 0;
+#if defined(CAVE_SIMD_SSE2)
+            if constexpr (IsAccelerated<T>::value){
+                static constexpr size_t lanes = registerSize / sizeof(T);
+                const Register v = splat(value);
+
+                for (; i + lanes <= n; i += lanes){
+                    const Mask mask = equalMask(data + i, v);
+                    if (mask){
+                        return i + countTrailingZeros(mask) / sizeof(T);
+                    }
+                }
+            }
+#endif
+            for (; i < n; i++){
+                if (data[i] == value){
+                    return i;
+                }
+            }
+            return n;
+        }
+
+        // How many elements are equal to value.
+        template <typename T>
+        size_t count(const T* data, size_t n, T value){
+            size_t i = 0;
+            size_t result = 0;
+#if defined(CAVE_SIMD_SSE2)
+            if constexpr (IsAccelerated<T>::value){
+                static constexpr size_t lanes = registerSize / sizeof(T);
+                const Register v = splat(value);
+
+                for (; i + lanes <= n; i += lanes){
+                    result += popCount(equalMask(data + i, v)) / sizeof(T);
+                }
+            }
+#endif
+            for (; i < n; i++){
+                if (data[i] == value){
+                    result++;
+                }
+            }
+            return result;
+        }
+
+        // Smallest and biggest elements of a NON EMPTY array. NaNs are skipped
+        // (unless the very first element is one), just like a scalar loop using <.
+        template <typename T>
+        void minMax(const T* data, size_t n, T& outMin, T& outMax){
+            T mn = data[0];
+            T mx = data[0];
+            size_t i = 1;
+
+#if defined(CAVE_SIMD_SSE2)
+            static constexpr bool isInt32 = std::is_integral<T>::value && sizeof(T) == 4;
+            static constexpr bool isFloat = std::is_same<T, float>::value;
+
+            if constexpr (isInt32 || isFloat){
+                static constexpr size_t lanes = registerSize / sizeof(T);
+                if (n >= lanes){
+                    // Every lane starts from the first element, so a NaN can only
+                    // poison the result if it's the first one (like the scalar loop).
+                    T lanesMin[lanes];
+                    T lanesMax[lanes];
+    #if defined(CAVE_SIMD_AVX2)
+                    if constexpr (isFloat){
+                        __m256 vMin = _mm256_set1_ps(mn);
+                        __m256 vMax = vMin;
+                        for (i = 0; i + lanes <= n; i += lanes){
+                            const __m256 x = _mm256_loadu_ps(data + i);
+                            vMin = _mm256_min_ps(x, vMin);
+                            vMax = _mm256_max_ps(x, vMax);
+                        }
+                        _mm256_storeu_ps(lanesMin, vMin);
+                        _mm256_storeu_ps(lanesMax, vMax);
+                    }
+                    else {
+                        __m256i vMin = _mm256_set1_epi32((int)mn);
+                        __m256i vMax = vMin;
+                        for (i = 0; i + lanes <= n; i += lanes){
+                            const __m256i x = _mm256_loadu_si256((const __m256i*)(data + i));
+                            if constexpr (std::is_signed<T>::value){
+                                vMin = _mm256_min_epi32(x, vMin);
+                                vMax = _mm256_max_epi32(x, vMax);
+                            }
+                            else {
+                                vMin = _mm256_min_epu32(x, vMin);
+                                vMax = _mm256_max_epu32(x, vMax);
+                            }
+                        }
+                        _mm256_storeu_si256((__m256i*)lanesMin, vMin);
+                        _mm256_storeu_si256((__m256i*)lanesMax, vMax);
+                    }
+    #else
+                    if constexpr (isFloat){
+                        __m128 vMin = _mm_set1_ps(mn);
+                        __m128 vMax = vMin;
+                        for (i = 0; i + lanes <= n; i += lanes){
+                            const __m128 x = _mm_loadu_ps(data + i);
+                            vMin = _mm_min_ps(x, vMin);
+                            vMax = _mm_max_ps(x, vMax);
+                        }
+                        _mm_storeu_ps(lanesMin, vMin);
+                        _mm_storeu_ps(lanesMax, vMax);
+                    }
+                    else {
+                        // SSE2 only has signed compares, so unsigned values are biased
+                        // by flipping their sign bit (and flipped back at the end).
+                        const __m128i bias = _mm_set1_epi32(std::is_signed<T>::value ? 0 : int(0x80000000u));
+
+                        __m128i vMin = _mm_xor_si128(_mm_set1_epi32((int)mn), bias);
+                        __m128i vMax = vMin;
+                        for (i = 0; i + lanes <= n; i += lanes){
+                            const __m128i x = _mm_xor_si128(_mm_loadu_si128((const __m128i*)(data + i)), bias);
+        #if defined(__SSE4_1__)
+                            vMin = _mm_min_epi32(x, vMin);
+                            vMax = _mm_max_epi32(x, vMax);
+        #else
+                            const __m128i lt = _mm_cmplt_epi32(x, vMin);
+                            vMin = _mm_or_si128(_mm_and_si128(lt, x), _mm_andnot_si128(lt, vMin));
+                            const __m128i gt = _mm_cmpgt_epi32(x, vMax);
+                            vMax = _mm_or_si128(_mm_and_si128(gt, x), _mm_andnot_si128(gt, vMax));
+        #endif
+                        }
+                        _mm_storeu_si128((__m128i*)lanesMin, _mm_xor_si128(vMin, bias));
+                        _mm_storeu_si128((__m128i*)lanesMax, _mm_xor_si128(vMax, bias));
+                    }
+    #endif
+                    mn = lanesMin[0];
+                    mx = lanesMax[0];
+                    for (size_t l = 1; l < lanes; l++){
+                        if (lanesMin[l] < mn){ mn = lanesMin[l]; }
+                        if (lanesMax[l] > mx){ mx = lanesMax[l]; }
+                    }
+                }
+            }
+#endif
+            for (; i < n; i++){
+                if (data[i] < mn){ mn = data[i]; }
+                if (data[i] > mx){ mx = data[i]; }
+            }
+            outMin = mn;
+            outMax = mx;
+        }
+
+        // Index of the first element that is NOT equal to value, or n if there is none.
+        template <typename T>
+        size_t findNot(const T* data, size_t n, T value){
+            size_t i = 0;
+#if defined(CAVE_SIMD_SSE2)
+            if constexpr (IsAccelerated<T>::value){
+                static constexpr size_t lanes = registerSize / sizeof(T);
+                static constexpr Mask allEqual = Mask((uint64_t(1) << registerSize) - 1);
+                const Register v = splat(value);
+
+                for (; i + lanes <= n; i += lanes){
+                    const Mask mask = equalMask(data + i, v);
+                    if (mask != allEqual){
+                        return i + countTrailingZeros(~mask) / sizeof(T);
+                    }
+                }
+            }
+#endif
+            for (; i < n; i++){
+                if (data[i] != value){
+                    return i;
+                }
+            }
+            return n;
+        }
+
+        // Bitwise kernels over arrays of words (see BitVector).
+        enum class BitOp { And, Or, Xor, AndNot };
+
+        // dst[i] = dst[i] op src[i]. AndNot means dst & ~src.
+        template <BitOp Op>
+        void bitwise(uint64_t* dst, const uint64_t* src, size_t n){
+            size_t i = 0;
+#if defined(CAVE_SIMD_AVX2)
+            for (; i + 4 <= n; i += 4){
+                const __m256i a = _mm256_loadu_si256((const __m256i*)(dst + i));
+                const __m256i b = _mm256_loadu_si256((const __m256i*)(src + i));
+                __m256i r;
+                if constexpr (Op == BitOp::And)      { r = _mm256_and_si256(a, b); }
+                else if constexpr (Op == BitOp::Or)  { r = _mm256_or_si256(a, b); }
+                else if constexpr (Op == BitOp::Xor) { r = _mm256_xor_si256(a, b); }
+                else                                 { r = _mm256_andnot_si256(b, a); }
+                _mm256_storeu_si256((__m256i*)(dst + i), r);
+            }
+#elif defined(CAVE_SIMD_SSE2)
+            for (; i + 2 <= n; i += 2){
+                const __m128i a = _mm_loadu_si128((const __m128i*)(dst + i));
+                const __m128i b = _mm_loadu_si128((const __m128i*)(src + i));
+                __m128i r;
+                if constexpr (Op == BitOp::And)      { r = _mm_and_si128(a, b); }
+                else if constexpr (Op == BitOp::Or)  { r = _mm_or_si128(a, b); }
+                else if constexpr (Op == BitOp::Xor) { r = _mm_xor_si128(a, b); }
+                else                                 { r = _mm_andnot_si128(b, a); }
+                _mm_storeu_si128((__m128i*)(dst + i), r);
+            }
+#endif
+            for (; i < n; i++){
+                if constexpr (Op == BitOp::And)      { dst[i] &= src[i]; }
+                else if constexpr (Op == BitOp::Or)  { dst[i] |= src[i]; }
+                else if constexpr (Op == BitOp::Xor) { dst[i] ^= src[i]; }
+                else                                 { dst[i] &= ~src[i]; }
+            }
+        }
+
+        // Total amount of set bits in an array of words.
+        inline size_t popCountWords(const uint64_t* data, size_t n){
+            size_t i = 0;
+            size_t result = 0;
+#if defined(CAVE_SIMD_AVX2)
+            // Nibble lookup table (Mula's method): per byte popcounts with shuffles,
+            // summed up into 64 bits lanes with sad.
+            const __m256i table = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                                   0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+            const __m256i low = _mm256_set1_epi8(0x0F);
+            __m256i total = _mm256_setzero_si256();
+            for (; i + 4 <= n; i += 4){
+                const __m256i v = _mm256_loadu_si256((const __m256i*)(data + i));
+                const __m256i lo = _mm256_shuffle_epi8(table, _mm256_and_si256(v, low));
+                const __m256i hi = _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(v, 4), low));
+                total = _mm256_add_epi64(total, _mm256_sad_epu8(_mm256_add_epi8(lo, hi), _mm256_setzero_si256()));
+            }
+            uint64_t lanes[4];
+            _mm256_storeu_si256((__m256i*)lanes, total);
+            result = size_t(lanes[0] + lanes[1] + lanes[2] + lanes[3]);
+#endif
+            for (; i < n; i++){
+                result += popCount64(data[i]);
+            }
+            return result;
+        }
+    }
+}
+
+#endif // !CAVE_STD_SIMD_H
@@ -0,0 +1,225 @@
+#ifndef CAVE_STD_SLOT_MAP_H
+#define CAVE_STD_SLOT_MAP_H
+
+#include <cstddef> // size_t
+#include <cstdint> // uint32_t
+#include <utility> // std::move, std::forward
+
+#include "Containers/Config.h"
+#include "Containers/Vector.h"
+#include "Containers/Exception.h"
+
+
+namespace cave {
+    // Stores the values densely (in a Vector) and hands out stable handles to
+    // them. Inserting and erasing are O(1), resolving a handle takes two array
+    // lookups and handles to erased values are detected thanks to a generation
+    // counter. Erasing moves the last value into the hole, so the iteration
+    // order is NOT stable.
+    template <typename T>
+    class SlotMap {
+    public:
+        static constexpr uint32_t invalidIndex = 0xFFFFFFFF;
+
+        struct Handle {
+            Handle() : index(invalidIndex), generation(0) {}
+            Handle(uint32_t index, uint32_t generation) : index(index), generation(generation) {}
+
+            bool operator==(const Handle& other) const {
+                return index == other.index && generation == other.generation;
+            }
+            bool operator!=(const Handle& other) const {
+                return !(*this == other);
+            }
+
+            uint32_t index;
+            uint32_t generation;
+        };
+
+        SlotMap() : m_freeHead(invalidIndex) {}
+        SlotMap(const SlotMap& other) = default;
+        SlotMap(SlotMap&& other) noexcept : m_values(std::move(other.m_values)), m_valueSlots(std::move(other.m_valueSlots)),
+            m_slots(std::move(other.m_slots)), m_freeHead(other.m_freeHead) {
+            other.m_freeHead = invalidIndex;
+        }
+        CAVE_CONTAINER_VIRTUAL ~SlotMap() {}
+
+        SlotMap& operator=(const SlotMap& other) = default;
+        SlotMap& operator=(SlotMap&& other) noexcept {
+            if (this != &other){
+                m_values = std::move(other.m_values);
+                m_valueSlots = std::move(other.m_valueSlots);
+                m_slots = std::move(other.m_slots);
+                m_freeHead = other.m_freeHead;
+                other.m_freeHead = invalidIndex;
+            }
+            return *this;
+        }
+
+        using Iterator = typename Vector<T>::Iterator;
+        using ConstIterator = typename Vector<T>::ConstIterator;
+
+        // Iterates over the values only (densely). Use handleAt(i) to get the
+        // handle of the i-th value.
+        Iterator begin() {
+            return m_values.begin();
+        }
+        ConstIterator begin() const {
+            return m_values.begin();
+        }
+        Iterator end() {
+            return m_values.end();
+        }
+        ConstIterator end() const {
+            return m_values.end();
+        }
+
+        Handle insert(const T& value){
+            return emplace(value);
+        }
+        Handle insert(T&& value){
+            return emplace(std::move(value));
+        }
+        template <typename... Args>
+        Handle emplace(Args&&... args){
+            uint32_t slotID = m_freeHead;
+            if (slotID != invalidIndex){
+                m_freeHead = m_slots[slotID].index;
+            }
+            else {
+                slotID = uint32_t(m_slots.size());
+                m_slots.pushBack(Slot{0, 0});
+            }
+
+            Slot& slot = m_slots[slotID];
+            slot.index = uint32_t(m_values.size());
+            m_values.emplaceBack(std::forward<Args>(args)...);
+            m_valueSlots.pushBack(slotID);
+
+            return Handle(slotID, slot.generation);
+        }
+
+        // Returns false if the handle was already invalid.
+        bool erase(const Handle& handle){
+            if (!contains(handle)){
+                return false;
+            }
+            Slot& slot = m_slots[handle.index];
+            const uint32_t id = slot.index;
+            const uint32_t last = uint32_t(m_values.size() - 1);
+
+            // The last value is moved into the hole, so its slot must follow it:
+            m_values.eraseUnordered(id);
+            if (id != last){
+                const uint32_t movedSlot = m_valueSlots[last];
+                m_slots[movedSlot].index = id;
+                m_valueSlots[id] = movedSlot;
+            }
+            m_valueSlots.popBack();
+
+            // Invalidating the handles to this slot and recycling it:
+            slot.generation++;
+            slot.index = m_freeHead;
+            m_freeHead = handle.index;
+            return true;
+        }
+
+        bool contains(const Handle& handle) const {
+            return handle.index < m_slots.size() && m_slots.data()[handle.index].generation == handle.generation;
+        }
+
+        // Returns nullptr if the handle is no longer valid.
+        T* get(const Handle& handle){
+            if (!contains(handle)){
+                return nullptr;
+            }
+            return &m_values[m_slots[handle.index].index];
+        }
+        const T* get(const Handle& handle) const {
+            if (!contains(handle)){
+                return nullptr;
+            }
+            return &m_values.data()[m_slots.data()[handle.index].index];
+        }
+
+        T& at(const Handle& handle){
+            T* value = get(handle);
+            if (value == nullptr){
+                throw cave::OutOfRangeException(handle.index);
+            }
+            return *value;
+        }
+        const T& at(const Handle& handle) const {
+            const T* value = get(handle);
+            if (value == nullptr){
+                throw cave::OutOfRangeException(handle.index);
+            }
+            return *value;
+        }
+
+        // No validation here! Use at() or get() if the handle may be stale.
+        T& operator[](const Handle& handle){
+            return m_values[m_slots[handle.index].index];
+        }
+        const T& operator[](const Handle& handle) const {
+            return m_values.data()[m_slots.data()[handle.index].index];
+        }
+
+        // Handle of the i-th value (in iteration order).
+        Handle handleAt(size_t pos) const {
+            const uint32_t slotID = m_valueSlots.at(pos);
+            return Handle(slotID, m_slots.data()[slotID].generation);
+        }
+
+        // The values, densely packed.
+        T* data() noexcept {
+            return m_values.data();
+        }
+        const T* data() const noexcept {
+            return m_values.data();
+        }
+
+        size_t size() const {
+            return m_values.size();
+        }
+        bool empty() const {
+            return m_values.empty();
+        }
+
+        void reserve(size_t n){
+            m_values.reserve(n);
+            m_valueSlots.reserve(n);
+            m_slots.reserve(n);
+        }
+
+        // Removes everything. All the existing handles become invalid.
+        void clear(){
+            // Only the live slots need a new generation (the free ones got it already).
+            for (uint32_t slotID : m_valueSlots){
+                m_slots[slotID].generation++;
+            }
+            m_values.clear();
+            m_valueSlots.clear();
+
+            m_freeHead = invalidIndex;
+            for (size_t i = m_slots.size(); i > 0; i--){
+                m_slots[i - 1].index = m_freeHead;
+                m_freeHead = uint32_t(i - 1);
+            }
+        }
+
+    private:
+        // While alive, index points to the value. While free, it's the next free slot.
+        struct Slot {
+            uint32_t index;
+            uint32_t generation;
+        };
+
+        Vector<T> m_values;
+        Vector<uint32_t> m_valueSlots;
+        Vector<Slot> m_slots;
+        uint32_t m_freeHead;
+    };
+}
+
+#endif // !CAVE_STD_SLOT_MAP_H
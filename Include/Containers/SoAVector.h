@@ -0,0 +1,295 @@
+#ifndef CAVE_STD_SOA_VECTOR_H
+#define CAVE_STD_SOA_VECTOR_H
+
+#include <cstddef> // size_t
+#include <utility> // std::move, std::forward, std::index_sequence
+#include <tuple>   // std::tuple_element
+#include <type_traits>
+
+#include "Containers/Config.h"
+#include "Containers/Memory.h"
+#include "Containers/Span.h"
+#include "Containers/Exception.h"
+
+
+namespace cave {
+    // Structure of arrays: behaves like a Vector of rows (Ts...), but each field
+    // lives in its own contiguous (and 64 bytes aligned) column. Great for systems
+    // that only touch some of the fields, and for SIMD kernels.
+    // Ex:  cave::SoAVector<Vec3, Quat, Vec3> transforms;
+    //      transforms.pushBack(position, rotation, scale);
+    //      cave::Span<Vec3> positions = transforms.column<0>();
+    template <typename... Ts>
+    class SoAVector {
+    public:
+        static_assert(sizeof...(Ts) > 0, "SoAVector needs at least one column.");
+
+        static constexpr size_t npos = -1;
+        static constexpr size_t minAllocatedSlots = 64;
+        static constexpr size_t columnAlignment = 64;
+        static constexpr size_t columnCount = sizeof...(Ts);
+
+        template <size_t I>
+        using ColumnType = typename std::tuple_element<I, std::tuple<Ts...>>::type;
+
+        SoAVector() : m_block(nullptr), m_size(0), m_allocated(0) {
+            for (size_t i=0; i<columnCount; i++){
+                m_columns[i] = nullptr;
+            }
+        }
+        SoAVector(const SoAVector& other) : SoAVector() {
+            copyFrom(other);
+        }
+        SoAVector(SoAVector&& other) noexcept : m_block(other.m_block), m_size(other.m_size), m_allocated(other.m_allocated) {
+            for (size_t i=0; i<columnCount; i++){
+                m_columns[i] = other.m_columns[i];
+                other.m_columns[i] = nullptr;
+            }
+            other.m_block = nullptr;
+            other.m_size = 0;
+            other.m_allocated = 0;
+        }
+        CAVE_CONTAINER_VIRTUAL ~SoAVector(){
+            clear();
+            memory::alignedFree(m_block);
+        }
+
+        SoAVector& operator=(const SoAVector& other){
+            if (this != &other){
+                clear();
+                copyFrom(other);
+            }
+            return *this;
+        }
+        SoAVector& operator=(SoAVector&& other) noexcept {
+            if (this != &other){
+                clear();
+                memory::alignedFree(m_block);
+
+                m_block = other.m_block;
+                m_size = other.m_size;
+                m_allocated = other.m_allocated;
+                for (size_t i=0; i<columnCount; i++){
+                    m_columns[i] = other.m_columns[i];
+                    other.m_columns[i] = nullptr;
+                }
+                other.m_block = nullptr;
+                other.m_size = 0;
+                other.m_allocated = 0;
+            }
+            return *this;
+        }
+
+        // Raw pointer to the first element of column I (nullptr if nothing was
+        // allocated yet). It's aligned to columnAlignment bytes.
+        template <size_t I>
+        ColumnType<I>* data() noexcept {
+            return static_cast<ColumnType<I>*>(m_columns[I]);
+        }
+        template <size_t I>
+        const ColumnType<I>* data() const noexcept {
+            return static_cast<const ColumnType<I>*>(m_columns[I]);
+        }
+
+        template <size_t I>
+        Span<ColumnType<I>> column() {
+            return Span<ColumnType<I>>(data<I>(), m_size);
+        }
+        template <size_t I>
+        Span<const ColumnType<I>> column() const {
+            return Span<const ColumnType<I>>(data<I>(), m_size);
+        }
+
+        template <size_t I>
+        ColumnType<I>& get(size_t pos) {
+            return data<I>()[pos];
+        }
+        template <size_t I>
+        const ColumnType<I>& get(size_t pos) const {
+            return data<I>()[pos];
+        }
+
+        template <size_t I>
+        ColumnType<I>& at(size_t pos) {
+            if (pos >= m_size){
+                throw cave::OutOfRangeException(pos);
+            }
+            return data<I>()[pos];
+        }
+        template <size_t I>
+        const ColumnType<I>& at(size_t pos) const {
+            if (pos >= m_size){
+                throw cave::OutOfRangeException(pos);
+            }
+            return data<I>()[pos];
+        }
+
+        void pushBack(const Ts&... values){
+            emplaceBack(values...);
+        }
+        // One argument per column, each one forwarded to its column constructor.
+        template <typename... Args>
+        void emplaceBack(Args&&... args){
+            static_assert(sizeof...(Args) == columnCount, "emplaceBack needs one argument per column.");
+            fitNewSize(m_size + 1);
+            emplaceInternal(std::index_sequence_for<Ts...>(), std::forward<Args>(args)...);
+            m_size++;
+        }
+
+        void popBack(){
+            if (m_size > 0){
+                m_size--;
+                forEachColumn([&](auto column){
+                    using C = ColumnType<decltype(column)::value>;
+                    data<decltype(column)::value>()[m_size].~C();
+                });
+            }
+        }
+
+        // Stable erase: the rows after pos are shifted down (in all the columns).
+        void erase(size_t pos){
+            erase(pos, pos + 1);
+        }
+        void erase(size_t first, size_t last){
+            if (last > m_size){
+                last = m_size;
+            }
+            if (last <= first){ return; }
+
+            size_t newSize = m_size;
+            forEachColumn([&](auto column){
+                newSize = memory::eraseRange(data<decltype(column)::value>(), m_size, first, last);
+            });
+            m_size = newSize;
+        }
+
+        // O(1) erase that doesn't keep the order: the last row is moved into pos.
+        void swapRemove(size_t pos){
+            if (pos >= m_size){ return; } // Out of range: nothing to erase (like erase).
+
+            if (pos + 1 < m_size){
+                forEachColumn([&](auto column){
+                    auto* col = data<decltype(column)::value>();
+                    memory::moveSlot(col[pos], col[m_size - 1]);
+                });
+            }
+            popBack();
+        }
+
+        size_t size() const {
+            return m_size;
+        }
+        bool empty() const {
+            return m_size == 0;
+        }
+        size_t capacity() const {
+            return m_allocated;
+        }
+
+        void reserve(size_t n){
+            fitNewSize(n);
+        }
+        // New rows are value-initialized (column by column).
+        void resize(size_t n){
+            if (n < m_size){
+                erase(n, m_size);
+                return;
+            }
+            fitNewSize(n);
+            forEachColumn([&](auto column){
+                using C = ColumnType<decltype(column)::value>;
+                C* col = data<decltype(column)::value>();
+                for (size_t i=m_size; i<n; i++){
+                    new(&col[i]) C();
+                }
+            });
+            m_size = n;
+        }
+        void shrinkToFit(){
+            fitNewSize(m_size, true);
+        }
+
+        void clear(){
+            forEachColumn([&](auto column){
+                using C = ColumnType<decltype(column)::value>;
+                C* col = data<decltype(column)::value>();
+                for (size_t i=0; i<m_size; i++){
+                    col[i].~C();
+                }
+            });
+            m_size = 0;
+        }
+
+    private:
+        template <class F>
+        void forEachColumn(F&& f){
+            forEachColumnInternal(std::index_sequence_for<Ts...>(), f);
+        }
+        template <size_t... Is, class F>
+        static void forEachColumnInternal(std::index_sequence<Is...>, F& f){
+            (f(std::integral_constant<size_t, Is>()), ...);
+        }
+
+        template <size_t... Is, typename... Args>
+        void emplaceInternal(std::index_sequence<Is...>, Args&&... args){
+            (new(&data<Is>()[m_size]) ColumnType<Is>(std::forward<Args>(args)), ...);
+        }
+
+        void copyFrom(const SoAVector& other){
+            fitNewSize(other.m_size);
+            forEachColumn([&](auto column){
+                constexpr size_t I = decltype(column)::value;
+                using C = ColumnType<I>;
+                C* col = data<I>();
+                const C* src = other.data<I>();
+                for (size_t i=0; i<other.m_size; i++){
+                    new(&col[i]) C(src[i]);
+                }
+            });
+            m_size = other.m_size;
+        }
+
+        // Byte offset of each column inside a block for `capacity` rows. Returns
+        // the total block size.
+        static size_t computeLayout(size_t capacity, size_t* offsets){
+            size_t offset = 0;
+            size_t i = 0;
+            ((offsets[i++] = offset, offset = alignOffset(offset + capacity * sizeof(Ts))), ...);
+            return offset;
+        }
+        static size_t alignOffset(size_t offset){
+            return (offset + columnAlignment - 1) & ~(columnAlignment - 1);
+        }
+
+        // Same growth policy as Vector. All the columns live in a single block.
+        void fitNewSize(size_t newSize, bool shrink=false){
+            if (newSize > m_allocated || shrink){
+                const size_t v = memory::growCapacity(newSize, minAllocatedSlots);
+
+                size_t offsets[columnCount];
+                const size_t total = computeLayout(v, offsets);
+                char* newBlock = (char*)memory::alignedAlloc(total, columnAlignment);
+
+                forEachColumn([&](auto column){
+                    constexpr size_t I = decltype(column)::value;
+                    ColumnType<I>* dst = (ColumnType<I>*)(newBlock + offsets[I]);
+                    if (m_block){
+                        memory::relocate(dst, data<I>(), m_size);
+                    }
+                    m_columns[I] = dst;
+                });
+
+                memory::alignedFree(m_block);
+                m_block = newBlock;
+                m_allocated = v;
+            }
+        }
+
+        void* m_block;
+        void* m_columns[columnCount];
+        size_t m_size;
+        size_t m_allocated;
+    };
+}
+
+#endif // !CAVE_STD_SOA_VECTOR_H
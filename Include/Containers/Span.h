@@ -0,0 +1,46 @@
+#ifndef CAVE_STD_SPAN_H
+#define CAVE_STD_SPAN_H
+
+#include <cstddef> // size_t
+
+#include "Containers/Exception.h"
+
+
+namespace cave {
+    // Non owning view of a contiguous block of elements (pointer + size). It's
+    // only valid while the container that handed it out isn't modified.
+    template <typename T>
+    class Span {
+    public:
+        Span() : m_data(nullptr), m_size(0) {}
+        Span(T* data, size_t size) : m_data(data), m_size(size) {}
+
+        using iterator = T*;
+
+        T* begin() const { return m_data; }
+        T* end()   const { return m_data + m_size; }
+
+        T& operator[](size_t pos) const {
+            return m_data[pos];
+        }
+        T& at(size_t pos) const {
+            if (pos >= m_size){
+                throw cave::OutOfRangeException(pos);
+            }
+            return m_data[pos];
+        }
+
+        T& front() const { return m_data[0]; }
+        T& back()  const { return m_data[m_size - 1]; }
+
+        T* data() const { return m_data; }
+        size_t size() const { return m_size; }
+        bool empty() const { return m_size == 0; }
+
+    private:
+        T* m_data;
+        size_t m_size;
+    };
+}
+
+#endif // !CAVE_STD_SPAN_H
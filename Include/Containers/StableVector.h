@@ -0,0 +1,209 @@
+#ifndef CAVE_STD_STABLE_VECTOR_H
+#define CAVE_STD_STABLE_VECTOR_H
+
+#include <cstddef> // size_t
+#include <utility> // std::move, std::forward
+#include <initializer_list>
+
+#include "Containers/Config.h"
+#include "Containers/Vector.h"
+#include "Containers/Memory.h"
+#include "Containers/Exception.h"
+#include "Containers/IndexIterator.h"
+
+
+namespace cave {
+    // Segmented array: the elements live in fixed size chunks (ChunkSize must be a
+    // power of two) that are never reallocated, so pointers and references to
+    // the elements stay valid for as long as they are alive. Growing only
+    // allocates a new chunk (no element is ever copied or moved), and indexing
+    // is a shift and a mask away.
+    template <typename T, size_t ChunkSize = 256>
+    class StableVector {
+    public:
+        static_assert(ChunkSize > 0 && (ChunkSize & (ChunkSize - 1)) == 0, "ChunkSize must be a power of two.");
+
+        static constexpr size_t npos = -1;
+        static constexpr size_t chunkSize = ChunkSize;
+
+        StableVector() : m_size(0) {}
+        StableVector(std::initializer_list<T> initList) : m_size(0) {
+            for (const auto& obj: initList){
+                pushBack(obj);
+            }
+        }
+        StableVector(const StableVector& other) : m_size(0) {
+            reserve(other.m_size);
+            for (size_t i=0; i<other.m_size; i++){
+                pushBack(other[i]);
+            }
+        }
+        StableVector(StableVector&& other) noexcept : m_chunks(std::move(other.m_chunks)), m_size(other.m_size) {
+            other.m_size = 0;
+        }
+        CAVE_CONTAINER_VIRTUAL ~StableVector(){
+            clear();
+            freeChunks(0);
+        }
+
+        StableVector& operator=(const StableVector& other){
+            if (this != &other){
+                clear();
+                reserve(other.m_size);
+                for (size_t i=0; i<other.m_size; i++){
+                    pushBack(other[i]);
+                }
+            }
+            return *this;
+        }
+        StableVector& operator=(StableVector&& other) noexcept {
+            if (this != &other){
+                clear();
+                freeChunks(0);
+                m_chunks = std::move(other.m_chunks);
+                m_size = other.m_size;
+                other.m_size = 0;
+            }
+            return *this;
+        }
+
+        using Iterator = IndexIterator<StableVector, false>;
+        using ConstIterator = IndexIterator<StableVector, true>;
+
+        Iterator begin() {
+            return Iterator(this, 0);
+        }
+        ConstIterator begin() const {
+            return ConstIterator(this, 0);
+        }
+        Iterator end() {
+            return Iterator(this, m_size);
+        }
+        ConstIterator end() const {
+            return ConstIterator(this, m_size);
+        }
+
+        T& operator[](size_t pos) {
+            return m_chunks[pos / ChunkSize][pos & (ChunkSize - 1)];
+        }
+        const T& operator[](size_t pos) const {
+            return m_chunks.data()[pos / ChunkSize][pos & (ChunkSize - 1)];
+        }
+
+        T& at(size_t pos) {
+            if (pos >= m_size){
+                throw cave::OutOfRangeException(pos);
+            }
+            return (*this)[pos];
+        }
+        const T& at(size_t pos) const {
+            if (pos >= m_size){
+                throw cave::OutOfRangeException(pos);
+            }
+            return (*this)[pos];
+        }
+
+        T& front() {
+            return (*this)[0];
+        }
+        const T& front() const {
+            return (*this)[0];
+        }
+        T& back() {
+            return (*this)[m_size - 1];
+        }
+        const T& back() const {
+            return (*this)[m_size - 1];
+        }
+
+        void pushBack(const T& value){
+            emplaceBack(value);
+        }
+        void pushBack(T&& value){
+            emplaceBack(std::move(value));
+        }
+        template <typename... Args>
+        T& emplaceBack(Args&&... args){
+            if (m_size == capacity()){
+                allocateChunk();
+            }
+            T* slot = &(*this)[m_size];
+            new(slot) T(std::forward<Args>(args)...);
+            m_size++;
+            return *slot;
+        }
+
+        void popBack(){
+            if (m_size > 0){
+                m_size--;
+                (*this)[m_size].~T();
+            }
+        }
+
+        // For compatibility with the std style naming:
+        inline void push_back(const T& value) { pushBack(value); }
+        inline void push_back(T&& value) { pushBack(std::move(value)); }
+        template<typename... Args>
+        inline void emplace_back(Args&&... args) { emplaceBack(std::forward<Args>(args)...); }
+        inline void pop_back() { popBack(); }
+
+        size_t size() const {
+            return m_size;
+        }
+        bool empty() const {
+            return m_size == 0;
+        }
+        size_t capacity() const {
+            return m_chunks.size() * ChunkSize;
+        }
+        size_t chunkCount() const {
+            return m_chunks.size();
+        }
+
+        void reserve(size_t n){
+            while (capacity() < n){
+                allocateChunk();
+            }
+        }
+        void resize(size_t n){
+            while (m_size > n){
+                popBack();
+            }
+            reserve(n);
+            while (m_size < n){
+                emplaceBack();
+            }
+        }
+
+        // Releases the chunks that are completely unused.
+        void shrinkToFit(){
+            freeChunks((m_size + ChunkSize - 1) / ChunkSize);
+        }
+
+        // Destroys all the elements, but keeps the chunks around to be reused.
+        void clear(){
+            for (size_t i=0; i<m_size; i++){
+                (*this)[i].~T();
+            }
+            m_size = 0;
+        }
+
+    private:
+        void allocateChunk(){
+            static constexpr size_t alignment = alignof(T) > sizeof(void*) ? alignof(T) : sizeof(void*);
+            m_chunks.pushBack((T*)memory::alignedAlloc(ChunkSize * sizeof(T), alignment));
+        }
+        // Frees the chunks from `first` onwards. They must hold no objects!
+        void freeChunks(size_t first){
+            while (m_chunks.size() > first){
+                memory::alignedFree(m_chunks.back());
+                m_chunks.popBack();
+            }
+        }
+
+        Vector<T*> m_chunks;
+        size_t m_size;
+    };
+}
+
+#endif // !CAVE_STD_STABLE_VECTOR_H
@@ -0,0 +1,278 @@
+#ifndef CAVE_STD_STATIC_VECTOR_H
+#define CAVE_STD_STATIC_VECTOR_H
+
+#include <cassert> // assert
+#include <cstddef> // size_t
+#include <utility> // std::move, std::forward
+#include <algorithm> // std::sort
+#include <initializer_list>
+
+#include "Containers/Config.h"
+#include "Containers/Memory.h"
+#include "Containers/Simd.h"
+#include "Containers/Exception.h"
+
+
+namespace cave {
+    // What a StaticVector does when it's full and something is added to it:
+    enum class OverflowPolicy {
+        Assert, // assert() in debug builds, unchecked (and fastest) in release.
+        Throw   // Throws cave::OutOfRangeException.
+    };
+
+    // Vector with a fixed (compile time) capacity and the storage inside the
+    // object itself, so it never touches the heap. Great for small scratch
+    // buffers in hot paths (contact points, per draw lists...).
+    // Ex:  cave::StaticVector<Contact, 8> contacts;
+    template <typename T, size_t N, OverflowPolicy Policy = OverflowPolicy::Assert>
+    class StaticVector {
+    public:
+        static_assert(N > 0, "StaticVector needs a capacity.");
+
+        static constexpr size_t npos = -1;
+        static constexpr OverflowPolicy overflowPolicy = Policy;
+
+        using Iterator = T*;
+        using ConstIterator = const T*;
+
+        StaticVector() : m_size(0) {}
+        StaticVector(std::initializer_list<T> initList) : m_size(0) {
+            for (const auto& obj: initList){
+                pushBack(obj);
+            }
+        }
+        StaticVector(const StaticVector& other) : m_size(0) {
+            copyFrom(other);
+        }
+        // Moves the elements one by one (there is no buffer to steal).
+        StaticVector(StaticVector&& other) : m_size(0) {
+            for (size_t i=0; i<other.m_size; i++){
+                new(&data()[i]) T(std::move(other.data()[i]));
+            }
+            m_size = other.m_size;
+            other.clear();
+        }
+        CAVE_CONTAINER_VIRTUAL ~StaticVector(){
+            clear();
+        }
+
+        StaticVector& operator=(const StaticVector& other){
+            if (this != &other){
+                clear();
+                copyFrom(other);
+            }
+            return *this;
+        }
+        StaticVector& operator=(StaticVector&& other){
+            if (this != &other){
+                clear();
+                for (size_t i=0; i<other.m_size; i++){
+                    new(&data()[i]) T(std::move(other.data()[i]));
+                }
+                m_size = other.m_size;
+                other.clear();
+            }
+            return *this;
+        }
+
+        bool operator==(const StaticVector& other) const {
+            if (m_size != other.m_size){
+                return false;
+            }
+            for (size_t i=0; i<m_size; i++){
+                if (data()[i] != other.data()[i]){
+                    return false;
+                }
+            }
+            return true;
+        }
+        bool operator!=(const StaticVector& other) const {
+            return !(*this == other);
+        }
+
+        Iterator begin() {
+            return data();
+        }
+        ConstIterator begin() const {
+            return data();
+        }
+        Iterator end() {
+            return data() + m_size;
+        }
+        ConstIterator end() const {
+            return data() + m_size;
+        }
+
+        T& front() {
+            return data()[0];
+        }
+        const T& front() const {
+            return data()[0];
+        }
+        T& back() {
+            return data()[m_size - 1];
+        }
+        const T& back() const {
+            return data()[m_size - 1];
+        }
+
+        T& operator[](size_t pos) {
+            return data()[pos];
+        }
+        const T& operator[](size_t pos) const {
+            return data()[pos];
+        }
+
+        T& at(size_t pos) {
+            if (pos >= m_size){
+                throw cave::OutOfRangeException(pos);
+            }
+            return data()[pos];
+        }
+        const T& at(size_t pos) const {
+            if (pos >= m_size){
+                throw cave::OutOfRangeException(pos);
+            }
+            return data()[pos];
+        }
+
+        void pushBack(const T& value){
+            emplaceBack(value);
+        }
+        void pushBack(T&& value){
+            emplaceBack(std::move(value));
+        }
+        template <typename... Args>
+        T& emplaceBack(Args&&... args){
+            checkOverflow(m_size + 1);
+            T* slot = &data()[m_size];
+            new(slot) T(std::forward<Args>(args)...);
+            m_size++;
+            return *slot;
+        }
+
+        void popBack(){
+            if (m_size > 0){
+                m_size--;
+                data()[m_size].~T();
+            }
+        }
+
+        // For compatibility with the std style naming:
+        inline void push_back(const T& value) { pushBack(value); }
+        inline void push_back(T&& value) { pushBack(std::move(value)); }
+        template<typename... Args>
+        inline void emplace_back(Args&&... args) { emplaceBack(std::forward<Args>(args)...); }
+        inline void pop_back() { popBack(); }
+
+        void erase(size_t pos){
+            erase(pos, pos + 1);
+        }
+        void erase(size_t first, size_t last){
+            if (last > m_size){
+                last = m_size;
+            }
+            if (last <= first){ return; }
+            m_size = memory::eraseRange(data(), m_size, first, last);
+        }
+        // O(1) erase that doesn't keep the order: the last element is moved into pos.
+        void eraseUnordered(size_t pos){
+            if (pos >= m_size){ return; } // Out of range: nothing to erase (like erase).
+
+            if (pos + 1 < m_size){
+                memory::moveSlot(data()[pos], data()[m_size - 1]);
+            }
+            popBack();
+        }
+
+        size_t findID(const T& object) const {
+            if constexpr (simd::IsAccelerated<T>::value){
+                const size_t id = simd::find(data(), m_size, object);
+                return id < m_size ? id : npos;
+            }
+            else {
+                for (size_t i=0; i<m_size; i++){
+                    if (data()[i] == object){
+                        return i;
+                    }
+                }
+                return npos;
+            }
+        }
+        bool contains(const T& object) const {
+            return findID(object) != npos;
+        }
+
+        void sort(){
+            std::sort(begin(), end());
+        }
+        template <class Compare>
+        void sort(Compare comp){
+            std::sort(begin(), end(), comp);
+        }
+
+        size_t size() const {
+            return m_size;
+        }
+        bool empty() const {
+            return m_size == 0;
+        }
+        bool full() const {
+            return m_size == N;
+        }
+        static constexpr size_t capacity() {
+            return N;
+        }
+
+        T* data() noexcept {
+            return reinterpret_cast<T*>(m_storage);
+        }
+        const T* data() const noexcept {
+            return reinterpret_cast<const T*>(m_storage);
+        }
+
+        void resize(size_t n){
+            if (n < m_size){
+                erase(n, m_size);
+                return;
+            }
+            checkOverflow(n);
+            for (size_t i=m_size; i<n; i++){
+                new(&data()[i]) T();
+            }
+            m_size = n;
+        }
+
+        void clear(){
+            for (size_t i=0; i<m_size; i++){
+                data()[i].~T();
+            }
+            m_size = 0;
+        }
+
+    private:
+        void copyFrom(const StaticVector& other){
+            for (size_t i=0; i<other.m_size; i++){
+                new(&data()[i]) T(other.data()[i]);
+            }
+            m_size = other.m_size;
+        }
+
+        void checkOverflow(size_t newSize) const {
+            if constexpr (Policy == OverflowPolicy::Throw){
+                if (newSize > N){
+                    throw cave::OutOfRangeException(newSize);
+                }
+            }
+            else {
+                assert(newSize <= N && "StaticVector overflow.");
+                (void)newSize;
+            }
+        }
+
+        alignas(T) unsigned char m_storage[N * sizeof(T)];
+        size_t m_size;
+    };
+}
+
+#endif // !CAVE_STD_STATIC_VECTOR_H
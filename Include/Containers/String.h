@@ -2,24 +2,49 @@
 #define CAVE_STD_STRING_H
 
 #include <cstddef> // size_t
+#include <cstdlib> // free
 #include <ostream> // operator<<
-#include <string>  // std::to_string
+#include <string>  // std::string
+#include <utility> // std::move
+
+#include "Containers/Config.h"
+#include "Containers/StringView.h"
+#include "Containers/StringNumbers.h"
+#include "Containers/Utf8.h"
 
 
 namespace cave {
+    // Short strings (up to localCapacity chars) are stored inside the object
+    // itself, so they never touch the heap. Longer ones grow geometrically.
+    // The whole string is three words (plus the vptr, see Config.h).
     class String {
     public:
         static constexpr size_t npos = -1;
+        // 22 on 64 bits.
+        static constexpr size_t localCapacity = sizeof(char*) + 2 * sizeof(size_t) - 2;
 
         String();
         String(const char* str);
         String(const std::string& other);
+        explicit String(StringView view);
         String(const String& other);
-        String(String&& other) noexcept;
-        virtual ~String();
+        // Inline (like the destructor), since every operator+ on a temporary
+        // moves it into the result.
+        String(String&& other) noexcept : m_heap(other.m_heap) {
+            // Local or not, it's the same three words.
+            other.resetToLocal();
+        }
+        CAVE_CONTAINER_VIRTUAL ~String(){
+            if (!isLocal()){
+                free(m_heap.data);
+            }
+        }
 
+        // Plain pointers, so they are random access iterators already.
         using iterator = char*;
         using const_iterator = const char*;
+        using Iterator = iterator;
+        using ConstIterator = const_iterator;
 
         iterator       begin();
         const_iterator begin() const;
@@ -34,17 +59,25 @@ namespace cave {
         const char& back() const;
 
         explicit operator const char* () const { return c_str(); }
+        // Strings can be passed to anything that takes a StringView.
+        operator StringView() const { return view(); }
+        StringView view() const {
+            return isLocal() ? StringView(m_local, localSize()) : StringView(m_heap.data, m_heap.size);
+        }
 
         friend auto operator<<(std::ostream& os, const String& str) -> std::ostream& {
-            if (str.m_data) { os << str.c_str(); }
+            const StringView view = str.view();
+            os.write(view.data(), view.size());
             return os;
         }
 
         bool operator==(const char* other)   const;
         bool operator==(const String& other) const;
+        bool operator==(StringView other)    const;
 
         bool operator!=(const char* other)   const;
         bool operator!=(const String& other) const;
+        bool operator!=(StringView other)    const;
 
         bool operator<(const char* other)   const;
         bool operator<(const String& other) const;
@@ -60,24 +93,31 @@ namespace cave {
         String& operator=(const std::string& other);
         String& operator=(const String& other);
         String& operator=(String&& other);
+        String& operator=(StringView view);
 
         String& operator+=(const char str);
         String& operator+=(const char* str);
         String& operator+=(const String& other);
-
-        String operator+(const char str);
-        String operator+(const char* str);
-        String operator+(const String& other);
-
-        friend String operator+(const char* lStr, const String& rStr) {
-            return cave::String(lStr) + rStr;
-        }
-        friend String operator+(const String& lStr, const char* rStr){
-            return cave::String(lStr) + cave::String(rStr);
-        }
-        friend String operator+(const String& lStr, const String& rStr){
-            return cave::String(lStr) + cave::String(rStr);
-        }
+        String& operator+=(StringView view);
+
+        // Concatenating allocates the result once (with the size of both parts).
+        // When the left side is a temporary its buffer is reused, so chains like
+        // a + "/" + b + ".ext" don't copy everything again at every step. To
+        // join many parts see cave::concat and cave::StringBuilder.
+        friend String operator+(const String& lStr, const String& rStr) { return concat(lStr, rStr); }
+        friend String operator+(const String& lStr, const char* rStr)   { return concat(lStr, rStr); }
+        friend String operator+(const String& lStr, StringView rStr)    { return concat(lStr, rStr); }
+        friend String operator+(const String& lStr, const char rStr)    { return concat(lStr, StringView(&rStr, 1)); }
+        friend String operator+(const char* lStr, const String& rStr)   { return concat(lStr, rStr); }
+        friend String operator+(StringView lStr, const String& rStr)    { return concat(lStr, rStr); }
+        friend String operator+(const String& lStr, const std::string& rStr) { return concat(lStr, rStr); }
+        friend String operator+(const std::string& lStr, const String& rStr) { return concat(lStr, rStr); }
+
+        friend String operator+(String&& lStr, const String& rStr) { lStr.append(rStr); return std::move(lStr); }
+        friend String operator+(String&& lStr, const char* rStr)   { lStr.append(StringView(rStr)); return std::move(lStr); }
+        friend String operator+(String&& lStr, StringView rStr)    { lStr.append(rStr); return std::move(lStr); }
+        friend String operator+(String&& lStr, const char rStr)    { lStr.append(rStr); return std::move(lStr); }
+        friend String operator+(String&& lStr, const std::string& rStr) { lStr.append(StringView(rStr)); return std::move(lStr); }
 
         char operator[](size_t pos) const;
         char& operator[](size_t pos);
@@ -96,46 +136,139 @@ namespace cave {
         void clear();
 
         void assign(const char* str);
+        void assign(const char* str, size_t count);
         void assign(const String& other);
+        void assign(StringView view);
 
         void append(const char str);
         void append(const char* str);
+        void append(const char* str, size_t count);
         void append(const String& other);
+        void append(StringView view);
 
         void pushBack(const char str);
         void popBack();
 
         int compare(const char* str) const;
         int compare(const String& other) const;
+        int compare(StringView other) const;
+
+        bool startsWith(StringView prefix) const;
+        bool endsWith(StringView suffix) const;
 
         size_t find(const char* str, size_t pos = 0) const;
         size_t find(const String& other, size_t pos = 0) const;
+        size_t find(StringView view, size_t pos = 0) const;
 
         size_t rfind(const char* str, size_t pos = npos) const;
         size_t rfind(const String& other, size_t pos = npos) const;
+        size_t rfind(StringView view, size_t pos = npos) const;
 
         String substr(size_t pos, size_t count = npos) const;
 
+        // Same as the ones above, but returning views into this string (so they
+        // don't allocate). They are invalidated when this string changes!
+        StringView substrView(size_t pos, size_t count = npos) const;
+        StringView trimView() const;
+        StringSplitRange splitView(char delimiter) const;
+
+        // These work in place (moving the tail with memmove) and only allocate
+        // when the result doesn't fit in the current capacity.
         String& replace(size_t pos, size_t len, const char* str);
         String& replace(size_t pos, size_t len, const String& str);
+        String& replace(size_t pos, size_t len, StringView str);
 
         String& insert(size_t pos, const char* str);
         String& insert(size_t pos, const String& str);
+        String& insert(size_t pos, StringView str);
 
         String& erase(size_t pos = 0, size_t len = npos);
 
+        // Replaces every (non overlapping) occurrence of pattern, from left to
+        // right, and returns how many were replaced. It's done in a single pass:
+        // in place when the string doesn't grow, otherwise into one allocation
+        // of the final size.
+        size_t replaceAll(StringView pattern, StringView replacement);
+
+        // The text as UTF-8 (see Utf8.h). The size() is always in bytes.
+        bool isValidUtf8() const;
+        size_t codePointCount() const;
+        // Ex:  for (char32_t c : text.codePoints()) { ... }
+        utf8::CodePointRange codePoints() const;
+
+        // The capacity doesn't count the null terminator.
         void reserve(size_t n);
         size_t capacity() const;
 
     private:
-        char* m_data;
-        size_t m_size;
-        size_t m_allocated;
+        // A heap string keeps these. A local one keeps its chars (and the null
+        // terminator) in the same bytes instead, and its size in the last one.
+        // That byte overlaps the highest byte of the heap capacity, which always
+        // has heapFlag set, so it tells the two apart.
+        struct Heap {
+            char* data;
+            size_t size;
+            size_t capacity; // Packed with the flag (see packCapacity).
+        };
+        static constexpr size_t lastByte = sizeof(Heap) - 1;
+        static constexpr unsigned char heapFlag = 0x80;
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        // The last byte is the lowest one of the capacity.
+        static size_t packCapacity(size_t capacity) { return (capacity << 8) | heapFlag; }
+        static size_t unpackCapacity(size_t packed) { return packed >> 8; }
+#else
+        static constexpr size_t heapBit = size_t(heapFlag) << (8 * (sizeof(size_t) - 1));
+        static size_t packCapacity(size_t capacity) { return capacity | heapBit; }
+        static size_t unpackCapacity(size_t packed) { return packed & ~heapBit; }
+#endif
+
+        bool isLocal() const { return ((unsigned char)m_local[lastByte] & heapFlag) == 0; }
+        size_t localSize() const { return (unsigned char)m_local[lastByte]; }
+        char* buffer() { return isLocal() ? m_local : m_heap.data; }
+        const char* buffer() const { return isLocal() ? m_local : m_heap.data; }
+        // Also writes the null terminator.
+        void setSize(size_t size){
+            if (isLocal()){
+                m_local[lastByte] = char(size);
+                m_local[size] = '\0';
+            }
+            else {
+                m_heap.size = size;
+                m_heap.data[size] = '\0';
+            }
+        }
+        // Back to an empty local string (it doesn't free anything!).
+        void resetToLocal(){
+            m_local[0] = '\0';
+            m_local[lastByte] = 0;
+        }
+        static String concat(StringView lStr, StringView rStr);
+        // Replaces [pos, pos + len) with count chars from str.
+        void replaceRange(size_t pos, size_t len, const char* str, size_t count);
+        // True if ptr points inside this string's buffer.
+        bool owns(const char* ptr) const {
+            const StringView chars = view();
+            return ptr >= chars.data() && ptr <= chars.data() + chars.size();
+        }
+
+        union {
+            Heap m_heap;
+            char m_local[sizeof(Heap)];
+        };
     };
 
+#ifdef CAVE_CONTAINERS_NO_VTABLE
+    static_assert(sizeof(String) == sizeof(char*) + 2 * sizeof(size_t), "cave::String should be three words.");
+#else
+    static_assert(sizeof(String) == 2 * sizeof(char*) + 2 * sizeof(size_t), "cave::String should be three words and the vptr.");
+#endif
+
+    // Numbers to text (see StringNumbers.h for the details and parseNumber).
     template <typename T>
     cave::String toString(const T& val) {
-        return cave::String(std::to_string(val).c_str());
+        cave::String out;
+        appendNumber(out, val);
+        return out;
     }
 }
 
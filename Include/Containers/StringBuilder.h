@@ -0,0 +1,139 @@
+#ifndef CAVE_STD_STRING_BUILDER_H
+#define CAVE_STD_STRING_BUILDER_H
+
+#include <cstddef> // size_t
+#include <utility> // std::move
+#include <type_traits>
+#include <initializer_list>
+
+#include "Containers/String.h"
+#include "Containers/StringView.h"
+#include "Containers/StringNumbers.h"
+
+
+namespace cave {
+    // Accumulates text into a single buffer and hands it over (without copying)
+    // as a String when done. Once it outgrows the local (SSO) buffer it jumps
+    // straight to minChunk chars and then doubles, so appending lots of small
+    // pieces barely reallocates.
+    // Ex:  cave::StringBuilder sb;
+    //      sb << "assets/" << folder << '/' << file << '_' << lod << ".fbx";
+    //      cave::String path = sb.build();
+    class StringBuilder {
+    public:
+        static constexpr size_t minChunk = 256;
+
+        StringBuilder() {}
+        explicit StringBuilder(size_t capacity) {
+            reserve(capacity);
+        }
+
+        StringBuilder& append(StringView str){
+            grow(str.size());
+            m_buffer.append(str);
+            return *this;
+        }
+        StringBuilder& append(const char* str){
+            return append(StringView(str));
+        }
+        StringBuilder& append(const String& str){
+            return append(str.view());
+        }
+        StringBuilder& append(char c){
+            grow(1);
+            m_buffer.append(c);
+            return *this;
+        }
+        // Numbers are written as text (see StringNumbers.h), chars stay chars.
+        template <typename T, typename = typename std::enable_if<std::is_arithmetic<T>::value &&
+            !std::is_same<T, char>::value && !std::is_same<T, bool>::value>::type>
+        StringBuilder& append(T value){
+            grow(maxNumberChars);
+            appendNumber(m_buffer, value);
+            return *this;
+        }
+        StringBuilder& append(bool value){
+            return append(value ? StringView("true") : StringView("false"));
+        }
+        // Appends c count times.
+        StringBuilder& append(size_t count, char c){
+            grow(count);
+            for (size_t i=0; i<count; i++){
+                m_buffer.append(c);
+            }
+            return *this;
+        }
+
+        template <typename T>
+        StringBuilder& operator<<(const T& value){
+            return append(value);
+        }
+
+        // Moves the text out (no copy). The builder is empty afterwards and can be reused.
+        String build(){
+            return std::move(m_buffer);
+        }
+
+        // The text so far (invalidated by the next append).
+        StringView view() const {
+            return m_buffer.view();
+        }
+        const char* c_str() const {
+            return m_buffer.c_str();
+        }
+        size_t size() const {
+            return m_buffer.size();
+        }
+        bool empty() const {
+            return m_buffer.empty();
+        }
+        size_t capacity() const {
+            return m_buffer.capacity();
+        }
+
+        void reserve(size_t n){
+            m_buffer.reserve(n);
+        }
+        // Keeps the buffer, so the next text is built without allocating.
+        void clear(){
+            m_buffer.clear();
+        }
+
+    private:
+        void grow(size_t extra){
+            const size_t needed = m_buffer.size() + extra;
+            if (needed > m_buffer.capacity()){
+                m_buffer.reserve(needed > minChunk ? needed : minChunk);
+            }
+        }
+
+        String m_buffer;
+    };
+
+    namespace strings {
+        // Anything that can be joined by cave::concat.
+        inline StringView toView(StringView part) { return part; }
+        inline StringView toView(const String& part) { return part.view(); }
+        inline StringView toView(const char* part) { return StringView(part); }
+        inline StringView toView(const char& part) { return StringView(&part, 1); }
+    }
+
+    // Joins all the parts with a single allocation (the sizes are summed first).
+    // Ex:  cave::String path = cave::concat(root, "/", name, ".ext");
+    template <typename... Parts>
+    String concat(const Parts&... parts){
+        const std::initializer_list<StringView> views = {strings::toView(parts)...};
+        size_t total = 0;
+        for (StringView v : views){
+            total += v.size();
+        }
+        String out;
+        out.reserve(total);
+        for (StringView v : views){
+            out.append(v);
+        }
+        return out;
+    }
+}
+
+#endif // !CAVE_STD_STRING_BUILDER_H
@@ -8,7 +8,7 @@ function. So just include this file into your code and it will do the trick.
 #define CAVE_STD_STRING_HASH_H
 
 #include <functional>
-#include <string>
+#include <string_view>
 
 #include "Containers/String.h"
 
@@ -17,7 +17,9 @@ namespace std {
     template<>
     struct hash<cave::String> {
         size_t operator()(const cave::String& s) const {
-            return hash<std::string>()(s.c_str());
+            // Through string_view, so it doesn't allocate. The result is the same
+            // as std::hash<std::string> and std::hash<cave::StringView>.
+            return hash<std::string_view>()(std::string_view(s.data(), s.size()));
         }
     };
 }
@@ -0,0 +1,64 @@
+/*
+Number <-> text conversions that never allocate on their own (no std::string
+in the middle). Floats are written with the shortest text that reads back to
+the exact same value (like 0.1 instead of 0.100000001).
+*/
+
+#ifndef CAVE_STD_STRING_NUMBERS_H
+#define CAVE_STD_STRING_NUMBERS_H
+
+#include <cstddef> // size_t
+
+#include "Containers/StringView.h"
+
+
+namespace cave {
+    class String;
+
+    // Big enough for any of the types below (including the sign and exponent,
+    // and the 36 digits of a 128 bits long double).
+    static constexpr size_t maxNumberChars = 48;
+
+    // Writes the number into buffer (at least maxNumberChars long, NOT null
+    // terminated) and returns how many chars were written.
+    size_t formatNumber(char* buffer, int value);
+    size_t formatNumber(char* buffer, unsigned int value);
+    size_t formatNumber(char* buffer, long value);
+    size_t formatNumber(char* buffer, unsigned long value);
+    size_t formatNumber(char* buffer, long long value);
+    size_t formatNumber(char* buffer, unsigned long long value);
+    size_t formatNumber(char* buffer, float value);
+    size_t formatNumber(char* buffer, double value);
+    size_t formatNumber(char* buffer, long double value);
+
+    // Appends the number to the end of str.
+    // Ex:  cave::appendNumber(line, 3.5f);
+    void appendNumber(String& str, int value);
+    void appendNumber(String& str, unsigned int value);
+    void appendNumber(String& str, long value);
+    void appendNumber(String& str, unsigned long value);
+    void appendNumber(String& str, long long value);
+    void appendNumber(String& str, unsigned long long value);
+    void appendNumber(String& str, float value);
+    void appendNumber(String& str, double value);
+    void appendNumber(String& str, long double value);
+
+    // Reads the WHOLE text as a number (an optional sign, then digits; floats
+    // also take a fraction, an exponent, "inf" and "nan"). Returns false (and
+    // leaves out untouched) if it's not a number, it has anything else around
+    // it (trim it first) or it doesn't fit in the type. The decimal point is
+    // always a '.', whatever the C locale is (long doubles too), and there's
+    // no limit on the size of the text.
+    // Ex:  float f; if (cave::parseNumber(value.trimView(), f)) { ... }
+    bool parseNumber(StringView str, int& out);
+    bool parseNumber(StringView str, unsigned int& out);
+    bool parseNumber(StringView str, long& out);
+    bool parseNumber(StringView str, unsigned long& out);
+    bool parseNumber(StringView str, long long& out);
+    bool parseNumber(StringView str, unsigned long long& out);
+    bool parseNumber(StringView str, float& out);
+    bool parseNumber(StringView str, double& out);
+    bool parseNumber(StringView str, long double& out);
+}
+
+#endif // !CAVE_STD_STRING_NUMBERS_H
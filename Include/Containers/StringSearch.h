@@ -0,0 +1,30 @@
+/*
+Substring search used by cave::String and cave::StringView (find and rfind).
+You usually don't need to include this file directly.
+*/
+
+#ifndef CAVE_STD_STRING_SEARCH_H
+#define CAVE_STD_STRING_SEARCH_H
+
+#include <cstddef> // size_t
+
+
+namespace cave {
+    namespace strings {
+        static constexpr size_t npos = -1;
+
+        // Index of the first occurrence of needle (size m) inside text (size n), or
+        // npos if there is none. An empty needle is found at zero.
+        // With SSE2/AVX2 the candidates are filtered a whole register at a time by
+        // matching the first AND the last char of the needle, so only a few
+        // positions are really compared. When the filter stops working (very
+        // repetitive text, like "aaaa...") it switches to the Two-Way algorithm,
+        // which is linear in the worst case. That's also the scalar fallback.
+        size_t findSubstring(const char* text, size_t n, const char* needle, size_t m);
+
+        // Same as findSubstring, but returns the LAST occurrence.
+        size_t rfindSubstring(const char* text, size_t n, const char* needle, size_t m);
+    }
+}
+
+#endif // !CAVE_STD_STRING_SEARCH_H
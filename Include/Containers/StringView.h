@@ -0,0 +1,236 @@
+#ifndef CAVE_STD_STRING_VIEW_H
+#define CAVE_STD_STRING_VIEW_H
+
+#include <cstddef> // size_t
+#include <cstring> // strlen, memcmp, memchr
+#include <ostream> // operator<<
+#include <string>  // std::string
+#include <string_view> // std::hash<std::string_view>
+#include <functional>
+
+#include "Containers/Exception.h"
+#include "Containers/StringSearch.h"
+
+
+namespace cave {
+    class StringSplitRange;
+
+    // Non owning view of a sequence of chars (pointer + size), so it's cheap to
+    // pass around and slicing it never allocates. Notice that it's NOT null
+    // terminated! It's only valid while the string it points to is alive.
+    class StringView {
+    public:
+        static constexpr size_t npos = -1;
+
+        constexpr StringView() : m_data(""), m_size(0) {}
+        StringView(const char* str) : m_data(str ? str : ""), m_size(str ? strlen(str) : 0) {}
+        constexpr StringView(const char* str, size_t size) : m_data(str), m_size(size) {}
+        StringView(const std::string& str) : m_data(str.data()), m_size(str.size()) {}
+
+        using iterator = const char*;
+        using const_iterator = const char*;
+
+        const char* begin() const { return m_data; }
+        const char* end()   const { return m_data + m_size; }
+
+        char operator[](size_t pos) const {
+            return m_data[pos];
+        }
+        char at(size_t pos) const {
+            if (pos >= m_size){
+                throw cave::OutOfRangeException(pos);
+            }
+            return m_data[pos];
+        }
+        char front() const { return m_data[0]; }
+        char back()  const { return m_data[m_size - 1]; }
+
+        const char* data() const { return m_data; }
+        size_t size() const { return m_size; }
+        size_t length() const { return m_size; }
+        bool empty() const { return m_size == 0; }
+
+        // Shrinks the view (no bounds check).
+        void removePrefix(size_t n){
+            m_data += n;
+            m_size -= n;
+        }
+        void removeSuffix(size_t n){
+            m_size -= n;
+        }
+
+        // Like String::substr, but it's just another view.
+        StringView substr(size_t pos, size_t count = npos) const {
+            if (pos > m_size){
+                pos = m_size;
+            }
+            if (count > m_size - pos){
+                count = m_size - pos;
+            }
+            return StringView(m_data + pos, count);
+        }
+
+        // Without the leading and trailing white spaces (space, \t, \n, \r, \v, \f).
+        StringView trim() const {
+            size_t first = 0;
+            size_t last = m_size;
+            while (first < last && isSpace(m_data[first])){
+                first++;
+            }
+            while (last > first && isSpace(m_data[last - 1])){
+                last--;
+            }
+            return StringView(m_data + first, last - first);
+        }
+
+        int compare(StringView other) const {
+            const size_t n = m_size < other.m_size ? m_size : other.m_size;
+            const int result = n > 0 ? memcmp(m_data, other.m_data, n) : 0;
+            if (result != 0){
+                return result;
+            }
+            return m_size < other.m_size ? -1 : (m_size > other.m_size ? 1 : 0);
+        }
+
+        bool startsWith(StringView prefix) const {
+            return prefix.m_size <= m_size && memcmp(m_data, prefix.m_data, prefix.m_size) == 0;
+        }
+        bool endsWith(StringView suffix) const {
+            return suffix.m_size <= m_size && memcmp(m_data + m_size - suffix.m_size, suffix.m_data, suffix.m_size) == 0;
+        }
+
+        size_t find(char c, size_t pos = 0) const {
+            if (pos >= m_size){
+                return npos;
+            }
+            const void* found = memchr(m_data + pos, c, m_size - pos);
+            return found ? size_t((const char*)found - m_data) : npos;
+        }
+        // See StringSearch.h.
+        size_t find(StringView str, size_t pos = 0) const {
+            if (pos > m_size){
+                return npos;
+            }
+            const size_t found = strings::findSubstring(m_data + pos, m_size - pos, str.m_data, str.m_size);
+            return found == strings::npos ? npos : pos + found;
+        }
+        size_t rfind(char c, size_t pos = npos) const {
+            if (m_size == 0){
+                return npos;
+            }
+            if (pos >= m_size){
+                pos = m_size - 1;
+            }
+            for (size_t i = pos + 1; i > 0; i--){
+                if (m_data[i - 1] == c){
+                    return i - 1;
+                }
+            }
+            return npos;
+        }
+        size_t rfind(StringView str, size_t pos = npos) const {
+            if (str.m_size > m_size){
+                return npos;
+            }
+            if (pos > m_size - str.m_size){
+                pos = m_size - str.m_size;
+            }
+            // Only the matches starting at pos or before it:
+            return strings::rfindSubstring(m_data, pos + str.m_size, str.m_data, str.m_size);
+        }
+        bool contains(StringView str) const {
+            return find(str) != npos;
+        }
+
+        // Range over the parts between the delimiters (without allocating).
+        // Ex:  for (cave::StringView dir : path.split('/')) { ... }
+        // Empty parts are kept: "a//b" gives "a", "" and "b".
+        StringSplitRange split(char delimiter) const;
+
+        std::string toStdString() const {
+            return std::string(m_data, m_size);
+        }
+
+        friend bool operator==(StringView lStr, StringView rStr) {
+            return lStr.m_size == rStr.m_size && (lStr.m_size == 0 || memcmp(lStr.m_data, rStr.m_data, lStr.m_size) == 0);
+        }
+        friend bool operator!=(StringView lStr, StringView rStr) { return !(lStr == rStr); }
+        friend bool operator<(StringView lStr, StringView rStr)  { return lStr.compare(rStr) < 0; }
+        friend bool operator>(StringView lStr, StringView rStr)  { return lStr.compare(rStr) > 0; }
+        friend bool operator<=(StringView lStr, StringView rStr) { return lStr.compare(rStr) <= 0; }
+        friend bool operator>=(StringView lStr, StringView rStr) { return lStr.compare(rStr) >= 0; }
+
+        friend auto operator<<(std::ostream& os, StringView str) -> std::ostream& {
+            os.write(str.m_data, str.m_size);
+            return os;
+        }
+
+    private:
+        static bool isSpace(char c){
+            return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+        }
+
+        const char* m_data;
+        size_t m_size;
+    };
+
+    // See StringView::split.
+    class StringSplitRange {
+    public:
+        struct Iterator {
+            Iterator(StringView rest, bool done, char delimiter) : m_rest(rest), m_done(done), m_delimiter(delimiter) {
+                findToken();
+            }
+
+            StringView operator*() const { return m_token; }
+            Iterator& operator++() {
+                if (m_token.end() == m_rest.end()){
+                    m_done = true;
+                }
+                else {
+                    m_rest = StringView(m_token.end() + 1, size_t(m_rest.end() - m_token.end() - 1));
+                    findToken();
+                }
+                return *this;
+            }
+            bool operator==(const Iterator& other) const { return m_done == other.m_done && (m_done || m_token.data() == other.m_token.data()); }
+            bool operator!=(const Iterator& other) const { return !(*this == other); }
+
+        private:
+            void findToken(){
+                const size_t pos = m_rest.find(m_delimiter);
+                m_token = m_rest.substr(0, pos);
+            }
+
+            StringView m_rest;
+            StringView m_token;
+            bool m_done;
+            char m_delimiter;
+        };
+
+        StringSplitRange(StringView str, char delimiter) : m_str(str), m_delimiter(delimiter) {}
+
+        Iterator begin() const { return Iterator(m_str, false, m_delimiter); }
+        Iterator end()   const { return Iterator(StringView(), true, m_delimiter); }
+
+    private:
+        StringView m_str;
+        char m_delimiter;
+    };
+
+    inline StringSplitRange StringView::split(char delimiter) const {
+        return StringSplitRange(*this, delimiter);
+    }
+}
+
+namespace std {
+    // Same hash as std::string (and cave::String) for the same chars.
+    template<>
+    struct hash<cave::StringView> {
+        size_t operator()(cave::StringView s) const {
+            return hash<std::string_view>()(std::string_view(s.data(), s.size()));
+        }
+    };
+}
+
+#endif // !CAVE_STD_STRING_VIEW_H
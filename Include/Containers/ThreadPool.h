@@ -0,0 +1,62 @@
+#ifndef CAVE_STD_THREAD_POOL_H
+#define CAVE_STD_THREAD_POOL_H
+
+#include <cstddef> // size_t
+#include <atomic>
+#include <condition_variable>
+#include <exception> // std::exception_ptr
+#include <functional>
+#include <mutex>
+#include <thread>
+
+
+namespace cave {
+    // Very simple pool of worker threads, used internally by the containers to
+    // split heavy work (like Vector::parallelSort) across the available cores.
+    // The only thing it knows how to do is a blocking parallel for.
+    class ThreadPool {
+    public:
+        // threadCount is the amount of worker threads. Zero means one less than the
+        // number of hardware threads, since the caller also helps with the work.
+        ThreadPool(size_t threadCount = 0);
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+        virtual ~ThreadPool();
+
+        // Calls task(i) for every i in [0, count) and only returns once all of them
+        // are done. The calling thread also runs tasks. If called from inside a task
+        // (or while another parallelFor is running), it runs everything serially.
+        // If a task throws, the tasks that didn't start yet are skipped and the
+        // (first) exception is rethrown here, once all the running ones are done.
+        void parallelFor(size_t count, const std::function<void(size_t)>& task);
+
+        size_t threadCount() const;
+
+        // Pool shared by the whole process (created on first use).
+        static ThreadPool& shared();
+
+    private:
+        void workerLoop();
+        void runTasks(const std::function<void(size_t)>* task, size_t count);
+
+        std::thread* m_threads;
+        size_t m_threadCount;
+
+        std::mutex m_mutex;
+        std::mutex m_runMutex;
+        std::condition_variable m_wakeUp;
+        std::condition_variable m_done;
+
+        const std::function<void(size_t)>* m_task;
+        size_t m_taskCount;
+        std::atomic<size_t> m_nextTask;
+        std::atomic<size_t> m_finishedTasks;
+        size_t m_generation;
+        size_t m_activeWorkers;
+        std::exception_ptr m_error;
+        std::atomic<bool> m_failed;
+        bool m_stop;
+    };
+}
+
+#endif // !CAVE_STD_THREAD_POOL_H
@@ -0,0 +1,160 @@
+/*
+UTF-8 helpers for cave::String (which stores the text as UTF-8 bytes):
+validation, decoding code points one by one and transcoding from/to UTF-16
+and UTF-32. Runs of ASCII (the most common case, even in localized text) are
+handled a whole SIMD register at a time (see Simd.h).
+
+Invalid bytes never stop the decoding: every byte that doesn't start a valid
+sequence (a stray continuation byte, a truncated sequence, an overlong
+encoding, a surrogate or anything above U+10FFFF) becomes one U+FFFD
+(replacementChar). Use isValid() first to reject those texts instead.
+*/
+
+#ifndef CAVE_STD_UTF8_H
+#define CAVE_STD_UTF8_H
+
+#include <cstddef> // size_t, std::ptrdiff_t
+#include <iterator> // std::forward_iterator_tag
+
+#include "Containers/StringView.h"
+
+
+namespace cave {
+    class String;
+
+    namespace utf8 {
+        static constexpr char32_t replacementChar = 0xFFFD;
+        // The most bytes a single code point takes.
+        static constexpr size_t maxSequenceSize = 4;
+
+        // True if the text is well formed UTF-8 (RFC 3629).
+        bool isValid(const char* str, size_t size);
+        inline bool isValid(StringView str){
+            return isValid(str.data(), str.size());
+        }
+
+        // Decodes the code point at the start of str (size must be > 0) and
+        // returns how many bytes it took (1 for an invalid byte, which decodes
+        // as replacementChar).
+        size_t decode(const char* str, size_t size, char32_t& out);
+
+        // Writes the code point into buffer (at least maxSequenceSize bytes long)
+        // and returns how many bytes were written. Invalid code points (surrogates
+        // and anything above U+10FFFF) are written as replacementChar.
+        size_t encode(char32_t codePoint, char* buffer);
+        void appendCodePoint(String& str, char32_t codePoint);
+
+        // How many code points decoding the text gives (so the size toUtf32 needs).
+        size_t countCodePoints(const char* str, size_t size);
+        inline size_t countCodePoints(StringView str){
+            return countCodePoints(str.data(), str.size());
+        }
+        // How many UTF-16 units the text takes (so the size toUtf16 needs).
+        size_t utf16Length(const char* str, size_t size);
+        inline size_t utf16Length(StringView str){
+            return utf16Length(str.data(), str.size());
+        }
+
+        // Transcode the text into out, which must have room for utf16Length() or
+        // countCodePoints() units. They return how many units were written.
+        // Ex:  cave::Vector<char16_t> wide;
+        //      wide.resize(cave::utf8::utf16Length(path) + 1);
+        //      wide[cave::utf8::toUtf16(path, wide.data())] = 0;
+        size_t toUtf16(const char* str, size_t size, char16_t* out);
+        size_t toUtf32(const char* str, size_t size, char32_t* out);
+        inline size_t toUtf16(StringView str, char16_t* out){
+            return toUtf16(str.data(), str.size(), out);
+        }
+        inline size_t toUtf32(StringView str, char32_t* out){
+            return toUtf32(str.data(), str.size(), out);
+        }
+
+        // Back to UTF-8 (allocating the result once). Unpaired UTF-16 surrogates
+        // and invalid code points become replacementChar.
+        String fromUtf16(const char16_t* str, size_t size);
+        String fromUtf32(const char32_t* str, size_t size);
+
+        // Walks the code points of a UTF-8 text. ASCII chars are decoded inline.
+        // Ex:  for (char32_t c : label.codePoints()) { font.drawGlyph(c); }
+        class CodePointIterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = char32_t;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const char32_t*;
+            using reference = char32_t;
+
+            CodePointIterator() : m_ptr(nullptr), m_end(nullptr), m_codePoint(0), m_length(0) {}
+            CodePointIterator(const char* ptr, const char* end) : m_ptr(ptr), m_end(end) {
+                read();
+            }
+
+            char32_t operator*() const {
+                return m_codePoint;
+            }
+            CodePointIterator& operator++(){
+                m_ptr += m_length;
+                read();
+                return *this;
+            }
+            CodePointIterator operator++(int){
+                CodePointIterator it = *this;
+                ++(*this);
+                return it;
+            }
+
+            // Where the current code point starts (and how many bytes it takes).
+            const char* position() const {
+                return m_ptr;
+            }
+            size_t sequenceSize() const {
+                return m_length;
+            }
+
+            bool operator==(const CodePointIterator& other) const { return m_ptr == other.m_ptr; }
+            bool operator!=(const CodePointIterator& other) const { return m_ptr != other.m_ptr; }
+
+        private:
+            void read(){
+                if (m_ptr == m_end){
+                    m_codePoint = 0;
+                    m_length = 0;
+                }
+                else if ((unsigned char)*m_ptr < 0x80){
+                    m_codePoint = (unsigned char)*m_ptr;
+                    m_length = 1;
+                }
+                else {
+                    m_length = decode(m_ptr, size_t(m_end - m_ptr), m_codePoint);
+                }
+            }
+
+            const char* m_ptr;
+            const char* m_end;
+            char32_t m_codePoint;
+            size_t m_length;
+        };
+
+        class CodePointRange {
+        public:
+            explicit CodePointRange(StringView str) : m_str(str) {}
+
+            CodePointIterator begin() const {
+                return CodePointIterator(m_str.data(), m_str.data() + m_str.size());
+            }
+            CodePointIterator end() const {
+                const char* last = m_str.data() + m_str.size();
+                return CodePointIterator(last, last);
+            }
+
+        private:
+            StringView m_str;
+        };
+
+        inline CodePointRange codePoints(StringView str){
+            return CodePointRange(str);
+        }
+    }
+}
+
+#endif // !CAVE_STD_UTF8_H
@@ -2,13 +2,23 @@
 #define CAVE_STD_VECTOR_H
 
 #include <cstddef> // size_t
+#include <cstdint> // uint8_t, uint64_t
 #include <utility> // std::move, std::forward
 #include <cstdlib> // malloc, free
+#include <cstring> // memcpy
 #include <cstddef> // std::ptrdiff_t
-#include <algorithm> // std::sort
+#include <iterator> // std::random_access_iterator_tag
+#include <algorithm> // std::sort, std::inplace_merge, std::lower_bound
+#include <functional> // std::less
+#include <type_traits> // std::is_trivially_copyable
 #include <initializer_list>
 
+#include "Containers/Config.h"
+#include "Containers/Pair.h"
+#include "Containers/Simd.h"
+#include "Containers/Memory.h"
 #include "Containers/Exception.h"
+#include "Containers/ThreadPool.h"
 
 
 namespace cave {
@@ -38,7 +48,7 @@ namespace cave {
             other.m_size = 0;
             other.m_allocated = 0;
         }
-        virtual ~Vector(){
+        CAVE_CONTAINER_VIRTUAL ~Vector(){
             // Destroying the remaining objects
             clear();
 
@@ -74,98 +84,121 @@ namespace cave {
             return *this;
         }
 
-        struct Iterator {
-            Iterator(const Iterator& other) : m_ptr(other.m_ptr) {}
-            Iterator(T* ptr) : m_ptr(ptr){}
+        // Random access iterator (with the std traits, so the std algorithms take
+        // their fast paths). ConstIterator is what you get from a const Vector.
+        template <bool IsConst>
+        struct IteratorBase {
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = typename std::conditional<IsConst, const T*, T*>::type;
+            using reference = typename std::conditional<IsConst, const T&, T&>::type;
+
+            IteratorBase() : m_ptr(nullptr) {}
+            IteratorBase(const IteratorBase& other) : m_ptr(other.m_ptr) {}
+            IteratorBase(pointer ptr) : m_ptr(ptr){}
+            // Iterator -> ConstIterator
+            template <bool C = IsConst, typename = typename std::enable_if<C>::type>
+            IteratorBase(const IteratorBase<false>& other) : m_ptr(other.getPointer()) {}
+
+            IteratorBase& operator=(const IteratorBase& other) {
+                m_ptr = other.m_ptr;
+                return *this;
+            }
 
-            T* getPointer() const {
+            pointer getPointer() const {
                 return m_ptr;
             }
 
-            T& operator*() {
+            reference operator*() const {
                 return *m_ptr;
             }
+            pointer operator->() const {
+                return m_ptr;
+            }
+            reference operator[](difference_type i) const {
+                return m_ptr[i];
+            }
 
-            friend std::ptrdiff_t operator-(const Iterator& lIter, const Iterator& rIter){
-                std::ptrdiff_t diff = lIter.m_ptr - rIter.m_ptr;
-                return diff;
+            friend difference_type operator-(const IteratorBase& lIter, const IteratorBase& rIter){
+                return lIter.m_ptr - rIter.m_ptr;
             }
             
-            Iterator& operator++() {
+            IteratorBase& operator++() {
                 ++m_ptr;
                 return *this;
             }
-            Iterator& operator--() {
+            IteratorBase& operator--() {
                 --m_ptr;
                 return *this;
             }
 
-            Iterator operator+(int i) const {
-                Iterator copy(*this);
-                copy.m_ptr += i;
-                return copy;
+            IteratorBase operator+(difference_type i) const {
+                return IteratorBase(m_ptr + i);
             }
-            Iterator operator-(int i) const {
-                Iterator copy(*this);
-                copy.m_ptr -= i;
-                return copy;
+            IteratorBase operator-(difference_type i) const {
+                return IteratorBase(m_ptr - i);
             }
-            Iterator& operator+=(int i) {
+            friend IteratorBase operator+(difference_type i, const IteratorBase& iter) {
+                return IteratorBase(iter.m_ptr + i);
+            }
+            IteratorBase& operator+=(difference_type i) {
                 m_ptr += i;
                 return *this;
             }
-
-            Iterator& operator-=(int i) {
+            IteratorBase& operator-=(difference_type i) {
                 m_ptr -= i;
                 return *this;
             }
 
-            Iterator operator++(int) {
-                Iterator copy(*this);
+            IteratorBase operator++(int) {
+                IteratorBase copy(*this);
                 ++(*this);
                 return copy;
             }
-            Iterator operator--(int) {
-                Iterator copy(*this);
+            IteratorBase operator--(int) {
+                IteratorBase copy(*this);
                 --(*this);
                 return copy;
             }
 
-            bool operator==(const Iterator& other) const {
-                return m_ptr == other.m_ptr;
+            // Friends, so an Iterator can be compared with a ConstIterator.
+            friend bool operator==(const IteratorBase& lIter, const IteratorBase& rIter) {
+                return lIter.m_ptr == rIter.m_ptr;
             }
-
-            bool operator!=(const Iterator& other) const {
-                return !(*this == other);
+            friend bool operator!=(const IteratorBase& lIter, const IteratorBase& rIter) {
+                return lIter.m_ptr != rIter.m_ptr;
+            }
+            friend bool operator<(const IteratorBase& lIter, const IteratorBase& rIter) {
+                return lIter.m_ptr < rIter.m_ptr;
+            }
+            friend bool operator>(const IteratorBase& lIter, const IteratorBase& rIter) {
+                return lIter.m_ptr > rIter.m_ptr;
+            }
+            friend bool operator<=(const IteratorBase& lIter, const IteratorBase& rIter) {
+                return lIter.m_ptr <= rIter.m_ptr;
+            }
+            friend bool operator>=(const IteratorBase& lIter, const IteratorBase& rIter) {
+                return lIter.m_ptr >= rIter.m_ptr;
             }
         private:
-            T* m_ptr;
+            pointer m_ptr;
         };
+        using Iterator = IteratorBase<false>;
+        using ConstIterator = IteratorBase<true>;
 
-        Iterator       begin() {
-            if (m_data){
-                return Iterator(&m_data[0]);
-            }
-            return Iterator(nullptr);
+        Iterator      begin() {
+            return Iterator(m_data);
         }
-        const Iterator begin() const {
-            if (m_data){
-                return Iterator(&m_data[0]);
-            }
-            return Iterator(nullptr);
+        ConstIterator begin() const {
+            return ConstIterator(m_data);
         }
 
-        Iterator       end() {
-            if (m_data){
-                return Iterator(&m_data[0] + m_size);
-            }
-            return Iterator(nullptr);
+        Iterator      end() {
+            return Iterator(m_data + m_size);
         }
-        const Iterator end()   const {
-            if (m_data){
-                return Iterator(&m_data[0] + m_size);
-            }
-            return Iterator(nullptr);
+        ConstIterator end()   const {
+            return ConstIterator(m_data + m_size);
         }
 
         T&       front() {
@@ -182,7 +215,7 @@ namespace cave {
             return m_data[m_size - 1];
         }
 
-        T  operator[](size_t pos) const {
+        const T& operator[](size_t pos) const {
             return m_data[pos];
         }
         T& operator[](size_t pos) {
@@ -209,7 +242,7 @@ namespace cave {
         }
         void pushBack(T&& value){
             fitNewSize(m_size + 1);
-            m_data[m_size] = std::move(value);
+            new(&m_data[m_size]) T(std::move(value));
             m_size++;
         }
         template<typename... Args>
@@ -238,34 +271,60 @@ namespace cave {
         inline void pop_back() { popBack(); }
         inline void shrink_to_fit() { shringToFit(); }
 
-        void erase(const Iterator& iter){
+        void erase(const ConstIterator& iter){
             std::ptrdiff_t index = iter.getPointer() - &m_data[0];
             erase(size_t(index));
         }
 
         void erase(size_t pos){
-            m_data[pos].~T();
-
-            for (size_t i = pos + 1; i< m_size; i++){
-                new(&m_data[i - 1]) T(std::move(m_data[i]));
-                //m_data[i - 1] = std::move(m_data[i]);
-            }
-            m_size--;
+            erase(pos, pos + 1);
         }
+        // Removes the elements in the [first, last) range, keeping the order
+        // of the remaining ones. The tail is moved down in a single pass.
         void erase(size_t first, size_t last){
-            if (last < first){ return; }
             if (last > m_size){
                 last = m_size;
             }
-            for (size_t i = first; i < last; i++){
-                m_data[i]->~T();
-                m_size--;
+            if (last <= first){ return; }
+
+            m_size = memory::eraseRange(m_data, m_size, first, last);
+        }
+
+        // O(1) erase that doesn't keep the order: the last element is moved
+        // into pos and then popped.
+        void eraseUnordered(size_t pos){
+            if (pos >= m_size){ return; } // Out of range: nothing to erase (like erase).
+
+            if (pos + 1 < m_size){
+                memory::moveSlot(m_data[pos], m_data[m_size - 1]);
             }
-            for (size_t i = last; i< m_size; i++){
-                new(&m_data[i - 1]) T(std::move(m_data[i]));
-                //m_data[i - 1] = std::move(m_data[i]);
+            popBack();
+        }
+        void eraseUnordered(const ConstIterator& iter){
+            std::ptrdiff_t index = iter.getPointer() - &m_data[0];
+            eraseUnordered(size_t(index));
+        }
+
+        // Removes every element for which pred(element) returns true, in a
+        // single (stable) pass. Returns how many elements were removed.
+        template <class Predicate>
+        size_t removeIf(Predicate pred){
+            size_t kept = 0;
+            for (size_t i = 0; i < m_size; i++){
+                if (pred(m_data[i])){
+                    continue;
+                }
+                if (kept != i){
+                    memory::moveSlot(m_data[kept], m_data[i]);
+                }
+                kept++;
             }
+            const size_t removed = m_size - kept;
+            erase(kept, m_size);
+            return removed;
         }
+        template <class Predicate>
+        inline size_t eraseIf(Predicate pred) { return removeIf(pred); }
 
         void append(const Vector& other){
             reserve(size() + other.size());
@@ -298,36 +357,231 @@ namespace cave {
             m_size++;
         }
 
+        // For numbers (ints, floats...) all the searching methods below use the SIMD
+        // kernels from Simd.h, comparing several elements per instruction.
         size_t findID(const T& object) const {
-            for (size_t i=0; i<m_size; i++){
-                if (m_data[i] == object){
-                    return i;
+            if constexpr (simd::IsAccelerated<T>::value){
+                const size_t id = simd::find(m_data, m_size, object);
+                return id < m_size ? id : npos;
+            }
+            else {
+                for (size_t i=0; i<m_size; i++){
+                    if (m_data[i] == object){
+                        return i;
+                    }
                 }
+                return npos;
             }
-            return npos;
         }
 
-        Iterator find(const T& element) const {
-            const auto endIt = end();
-            for (auto it=begin(); it != endIt; it++){
-                if (*it == element){
-                    return it;
+        Iterator find(const T& element) {
+            const size_t id = findID(element);
+            if (id == npos){
+                return end();
+            }
+            return Iterator(m_data + id);
+        }
+        ConstIterator find(const T& element) const {
+            const size_t id = findID(element);
+            if (id == npos){
+                return end();
+            }
+            return ConstIterator(m_data + id);
+        }
+
+        // Binary searches for sorted vectors (same as std::lower_bound and
+        // std::upper_bound), returning a position: size() if there is no such element.
+        // Use EytzingerArray if you search the same (big) vector a lot.
+        size_t lowerBound(const T& value) const {
+            return std::lower_bound(m_data, m_data + m_size, value) - m_data;
+        }
+        template <class Compare>
+        size_t lowerBound(const T& value, Compare comp) const {
+            return std::lower_bound(m_data, m_data + m_size, value, comp) - m_data;
+        }
+        size_t upperBound(const T& value) const {
+            return std::upper_bound(m_data, m_data + m_size, value) - m_data;
+        }
+        template <class Compare>
+        size_t upperBound(const T& value, Compare comp) const {
+            return std::upper_bound(m_data, m_data + m_size, value, comp) - m_data;
+        }
+
+        bool contains(const T& element) const {
+            return findID(element) != npos;
+        }
+
+        size_t count(const T& element) const {
+            if constexpr (simd::IsAccelerated<T>::value){
+                return simd::count(m_data, m_size, element);
+            }
+            else {
+                size_t result = 0;
+                for (size_t i=0; i<m_size; i++){
+                    if (m_data[i] == element){
+                        result++;
+                    }
+                }
+                return result;
+            }
+        }
+
+        // Returns the smallest (first) and biggest (second) elements.
+        // Throws an OutOfRangeException if the vector is empty.
+        cave::Pair<T, T> minMax() const {
+            if (m_size == 0){
+                throw cave::OutOfRangeException(0);
+            }
+            if constexpr (simd::IsAccelerated<T>::value){
+                T mn, mx;
+                simd::minMax(m_data, m_size, mn, mx);
+                return cave::Pair<T, T>(mn, mx);
+            }
+            else {
+                size_t mn = 0;
+                size_t mx = 0;
+                for (size_t i=1; i<m_size; i++){
+                    if (m_data[i] < m_data[mn]){ mn = i; }
+                    if (m_data[mx] < m_data[i]){ mx = i; }
                 }
+                return cave::Pair<T, T>(m_data[mn], m_data[mx]);
             }
-            return end();
         }
 
         void sort(){
-            T* first = begin().getPointer();
+            T* first = m_data;
             std::sort(first, first + m_size);
         }
 
         template <class Compare>
         void sort(Compare comp){
-            T* first = begin().getPointer();
+            T* first = m_data;
             std::sort(first, first + m_size, comp);
         }
 
+        // Same result as sort(), but the work is split in `threads` chunks that are
+        // sorted in parallel (using the shared ThreadPool) and then merged back
+        // together, also in parallel. Zero threads means one per hardware thread.
+        void parallelSort(size_t threads = 0){
+            parallelSort(threads, std::less<T>());
+        }
+
+        template <class Compare>
+        void parallelSort(size_t threads, Compare comp){
+            // Small arrays are not worth the synchronization...
+            static constexpr size_t minParallelSize = 16384;
+
+            if (threads == 0){
+                threads = ThreadPool::shared().threadCount() + 1;
+            }
+            if (threads > m_size / minParallelSize){
+                threads = m_size / minParallelSize;
+            }
+            if (threads <= 1){
+                sort(comp);
+                return;
+            }
+
+            // Splitting it in runs and sorting each one of them:
+            Vector<size_t> bounds;
+            bounds.resize(threads + 1);
+            for (size_t i=0; i<=threads; i++){
+                bounds[i] = (m_size * i) / threads;
+            }
+
+            T* first = m_data;
+            ThreadPool::shared().parallelFor(threads, [&](size_t i){
+                std::sort(first + bounds[i], first + bounds[i + 1], comp);
+            });
+
+            // Merging the runs in pairs until there is only one left:
+            size_t runs = threads;
+            while (runs > 1){
+                const size_t pairs = runs / 2;
+                ThreadPool::shared().parallelFor(pairs, [&](size_t i){
+                    std::inplace_merge(first + bounds[2*i], first + bounds[2*i + 1], 
+                        first + bounds[2*i + 2], comp);
+                });
+
+                size_t newRuns = 0;
+                for (size_t i=0; i<runs; i+=2){
+                    bounds[newRuns++] = bounds[i];
+                }
+                bounds[newRuns] = bounds[runs];
+                runs = newRuns;
+            }
+        }
+
+        // Linear time (LSD, 8 bits per pass) stable sort for vectors of integers or
+        // floating point numbers. Passes where all elements share the same byte
+        // are skipped. Floats are ordered by their bit pattern, so -0.0 comes
+        // before +0.0 and NaNs go to the ends.
+        void radixSort(){
+            static_assert(std::is_arithmetic<T>::value, "radixSort requires an arithmetic T. Use radixSortBy instead.");
+            radixSortBy([](const T& value){ return value; });
+        }
+
+        // Same as radixSort, but the elements are sorted by keyFn(element), which
+        // must return an integer or floating point key. Ex:
+        // drawCalls.radixSortBy([](const DrawCall& d){ return d.sortKey; });
+        template <class KeyFn>
+        void radixSortBy(KeyFn keyFn){
+            using Key = typename std::decay<decltype(keyFn(std::declval<const T&>()))>::type;
+            static_assert(std::is_arithmetic<Key>::value, "radixSortBy requires an arithmetic key.");
+            using Bits = decltype(radixKey(Key()));
+            static constexpr size_t passes = sizeof(Bits);
+
+            if (m_size < 2){
+                return;
+            }
+
+            // Building the histograms of all passes at once:
+            size_t counts[passes][256] = {};
+            for (size_t i=0; i<m_size; i++){
+                const Bits bits = radixKey(keyFn(m_data[i]));
+                for (size_t p=0; p<passes; p++){
+                    counts[p][(bits >> (p * 8)) & 0xFF]++;
+                }
+            }
+
+            T* src = m_data;
+            T* dst = (T*)malloc(m_size * sizeof(T));
+            T* buffer = dst;
+
+            for (size_t p=0; p<passes; p++){
+                const size_t shift = p * 8;
+                size_t* count = counts[p];
+
+                // All of them have the same digit here, nothing to do.
+                if (count[(radixKey(keyFn(src[0])) >> shift) & 0xFF] == m_size){
+                    continue;
+                }
+
+                size_t offset = 0;
+                for (size_t d=0; d<256; d++){
+                    const size_t c = count[d];
+                    count[d] = offset;
+                    offset += c;
+                }
+                for (size_t i=0; i<m_size; i++){
+                    const size_t digit = (radixKey(keyFn(src[i])) >> shift) & 0xFF;
+                    T* slot = &dst[count[digit]++];
+                    new(slot) T(std::move(src[i]));
+                    src[i].~T();
+                }
+                std::swap(src, dst);
+            }
+
+            // After an odd number of passes the result lives in the buffer:
+            if (src != m_data){
+                for (size_t i=0; i<m_size; i++){
+                    new(&m_data[i]) T(std::move(src[i]));
+                    src[i].~T();
+                }
+            }
+            free(buffer);
+        }
+
         size_t size()  const{
             return m_size;
         }
@@ -360,7 +614,7 @@ namespace cave {
             }
             else {
                 // Destroying the exceeded objects
-                for (size_t i=m_size; i< n; i++){
+                for (size_t i=n; i< m_size; i++){
                     m_data[i].~T();
                 }
             }
@@ -378,13 +632,63 @@ namespace cave {
             }
             else {
                 // Destroying the exceeded objects
+                for (size_t i=n; i< m_size; i++){
+                    m_data[i].~T();
+                }
+            }
+            m_size = n;
+        }
+
+        // Same as resize, but the new objects are default-initialized instead of
+        // value-initialized. For trivial types (int, float, PODs...) it means that
+        // the memory is NOT touched at all, which is what you want before reading
+        // a file (or anything else) straight into the buffer.
+        void resizeDefaultInit(size_t n) {
+            if (n == m_size) { return; }
+            fitNewSize(n);
+
+            if (n > m_size){
                 for (size_t i=m_size; i< n; i++){
+                    new(&m_data[i]) T;
+                }
+            }
+            else {
+                for (size_t i=n; i< m_size; i++){
                     m_data[i].~T();
                 }
             }
             m_size = n;
         }
 
+        // Grows (or shrinks) the vector without initializing anything. The new
+        // elements will hold garbage until you write them, so it's only allowed
+        // for trivially copyable types.
+        void resizeUninitialized(size_t n) {
+            static_assert(std::is_trivially_copyable<T>::value,
+                "resizeUninitialized requires a trivially copyable T. Use resizeDefaultInit instead.");
+            fitNewSize(n);
+            m_size = n;
+        }
+
+        // Reserves room for up to maxCount new elements at the end of the vector and
+        // lets the reader write straight into it. The reader is called as
+        // reader(T* tail, size_t maxCount) and must return how many elements it
+        // actually wrote (<= maxCount). Returns that same amount.
+        // Example:  buffer.appendFrom(4096, [&](uint8_t* p, size_t n){ return fread(p, 1, n, f); });
+        template <class Reader>
+        size_t appendFrom(size_t maxCount, Reader reader) {
+            static_assert(std::is_trivially_copyable<T>::value,
+                "appendFrom requires a trivially copyable T.");
+            fitNewSize(m_size + maxCount);
+
+            size_t written = reader(m_data + m_size, maxCount);
+            if (written > maxCount){
+                written = maxCount;
+            }
+            m_size += written;
+            return written;
+        }
+
         void clear(){
             // Destroying all the objects
             for (size_t i=0; i < m_size; i++){
@@ -393,18 +697,34 @@ namespace cave {
             m_size = 0;
         }
     private:
+        // Maps a key to an unsigned integer of the same size that sorts the same way
+        // (sign bit flipped for signed integers, the float bit-flip trick for floats).
+        template <typename K>
+        static auto radixKey(K key){
+            using Bits = typename std::conditional<sizeof(K) == 1, uint8_t,
+                         typename std::conditional<sizeof(K) == 2, uint16_t,
+                         typename std::conditional<sizeof(K) == 4, uint32_t, uint64_t>::type>::type>::type;
+            static_assert(sizeof(K) <= sizeof(uint64_t), "Radix sort keys can't be bigger than 64 bits.");
+            static constexpr Bits signBit = Bits(Bits(1) << (sizeof(Bits) * 8 - 1));
+
+            Bits bits;
+            memcpy(&bits, &key, sizeof(K));
+
+            if constexpr (std::is_floating_point<K>::value){
+                return Bits((bits & signBit) ? ~bits : (bits | signBit));
+            }
+            else if constexpr (std::is_signed<K>::value){
+                return Bits(bits ^ signBit);
+            }
+            else {
+                return bits;
+            }
+        }
+
         void fitNewSize(size_t newSize, bool shrink=false){
             if (newSize > m_allocated || shrink){
                 // The minimum allocation size will be 64 slots!
-                size_t v = minAllocatedSlots;
-
-                if (newSize >= v){
-                    // It's finding the next power of two to use
-                    v = newSize - 1;
-                    v |= v >> 1; v |= v >> 2; 
-                    v |= v >> 4; v |= v >> 8; 
-                    v |= v >> 16; v++;
-                }
+                const size_t v = memory::growCapacity(newSize, minAllocatedSlots);
                 m_allocated = v;
 
                 // Not constructing this!
@@ -412,11 +732,7 @@ namespace cave {
                 T* newData = (T*)malloc((v + 1) * sizeof(T));
 
                 if (m_data){
-                    for (size_t i=0; i<m_size; i++){
-                        new(&newData[i]) T(std::move(m_data[i]));
-                        //newData[i] = std::move(m_data[i]);
-                    }
-                    // Also not destructing this!
+                    memory::relocate(newData, m_data, m_size);
                     free(m_data);
                 }
                 m_data = newData;
@@ -0,0 +1,178 @@
+#include "Containers/BitVector.h"
+
+#include <utility> // std::move
+
+#include "Containers/Simd.h"
+#include "Containers/Exception.h"
+
+
+cave::BitVector::BitVector() : m_size(0) {}
+cave::BitVector::BitVector(size_t n, bool value) : m_size(0) {
+    resize(n, value);
+}
+cave::BitVector::BitVector(const cave::BitVector& other) : m_words(other.m_words), m_size(other.m_size) {}
+cave::BitVector::BitVector(cave::BitVector&& other) noexcept : m_words(std::move(other.m_words)), m_size(other.m_size) {
+    other.m_size = 0;
+}
+cave::BitVector::~BitVector() {}
+
+cave::BitVector& cave::BitVector::operator=(const cave::BitVector& other){
+    if (this != &other){
+        m_words = other.m_words;
+        m_size = other.m_size;
+    }
+    return *this;
+}
+cave::BitVector& cave::BitVector::operator=(cave::BitVector&& other) noexcept {
+    if (this != &other){
+        m_words = std::move(other.m_words);
+        m_size = other.m_size;
+        other.m_size = 0;
+    }
+    return *this;
+}
+
+bool cave::BitVector::operator==(const cave::BitVector& other) const {
+    // The unused bits are always zero, so comparing the words is enough.
+    return m_size == other.m_size && m_words == other.m_words;
+}
+bool cave::BitVector::operator!=(const cave::BitVector& other) const {
+    return !(*this == other);
+}
+
+bool cave::BitVector::at(size_t pos) const {
+    if (pos >= m_size){
+        throw cave::OutOfRangeException(pos);
+    }
+    return (*this)[pos];
+}
+
+void cave::BitVector::setAll(bool value){
+    const uint64_t word = value ? ~uint64_t(0) : 0;
+    for (size_t i=0; i<m_words.size(); i++){
+        m_words[i] = word;
+    }
+    clearUnusedBits();
+}
+void cave::BitVector::flipAll(){
+    for (size_t i=0; i<m_words.size(); i++){
+        m_words[i] = ~m_words[i];
+    }
+    clearUnusedBits();
+}
+
+void cave::BitVector::pushBack(bool value){
+    if (m_size % bitsPerWord == 0){
+        m_words.pushBack(0);
+    }
+    m_size++;
+    if (value){
+        set(m_size - 1);
+    }
+}
+void cave::BitVector::popBack(){
+    if (m_size > 0){
+        resize(m_size - 1);
+    }
+}
+
+size_t cave::BitVector::count() const {
+    return simd::popCountWords(m_words.data(), m_words.size());
+}
+bool cave::BitVector::any() const {
+    return findFirst() != npos;
+}
+bool cave::BitVector::none() const {
+    return !any();
+}
+bool cave::BitVector::all() const {
+    return count() == m_size;
+}
+
+size_t cave::BitVector::findFirst() const {
+    const size_t w = simd::findNot<uint64_t>(m_words.data(), m_words.size(), 0);
+    if (w == m_words.size()){
+        return npos;
+    }
+    return w * bitsPerWord + simd::countTrailingZeros64(m_words.data()[w]);
+}
+size_t cave::BitVector::findNext(size_t pos) const {
+    pos++;
+    if (pos >= m_size){
+        return npos;
+    }
+    // The rest of the current word first...
+    size_t w = pos / bitsPerWord;
+    const uint64_t rest = m_words.data()[w] & (~uint64_t(0) << (pos % bitsPerWord));
+    if (rest){
+        return w * bitsPerWord + simd::countTrailingZeros64(rest);
+    }
+    // ...and then skipping the empty words in bulk.
+    w++;
+    const size_t found = w + simd::findNot<uint64_t>(m_words.data() + w, m_words.size() - w, 0);
+    if (found == m_words.size()){
+        return npos;
+    }
+    return found * bitsPerWord + simd::countTrailingZeros64(m_words.data()[found]);
+}
+
+cave::BitVector& cave::BitVector::operator&=(const cave::BitVector& other){
+    checkSameSize(other);
+    simd::bitwise<simd::BitOp::And>(m_words.data(), other.m_words.data(), m_words.size());
+    return *this;
+}
+cave::BitVector& cave::BitVector::operator|=(const cave::BitVector& other){
+    checkSameSize(other);
+    simd::bitwise<simd::BitOp::Or>(m_words.data(), other.m_words.data(), m_words.size());
+    return *this;
+}
+cave::BitVector& cave::BitVector::operator^=(const cave::BitVector& other){
+    checkSameSize(other);
+    simd::bitwise<simd::BitOp::Xor>(m_words.data(), other.m_words.data(), m_words.size());
+    return *this;
+}
+cave::BitVector& cave::BitVector::andNot(const cave::BitVector& other){
+    checkSameSize(other);
+    simd::bitwise<simd::BitOp::AndNot>(m_words.data(), other.m_words.data(), m_words.size());
+    return *this;
+}
+
+void cave::BitVector::resize(size_t n, bool value){
+    const size_t oldSize = m_size;
+    const size_t oldWords = m_words.size();
+
+    m_words.resize(wordsFor(n));
+    m_size = n;
+    if (n <= oldSize){
+        clearUnusedBits();
+        return;
+    }
+    // The new words are zeroed by the Vector (and so is the old tail).
+    if (value){
+        if (oldSize % bitsPerWord != 0){
+            m_words[oldWords - 1] |= ~uint64_t(0) << (oldSize % bitsPerWord);
+        }
+        for (size_t i=oldWords; i<m_words.size(); i++){
+            m_words[i] = ~uint64_t(0);
+        }
+        clearUnusedBits();
+    }
+}
+void cave::BitVector::reserve(size_t n){
+    m_words.reserve(wordsFor(n));
+}
+void cave::BitVector::clear(){
+    m_words.clear();
+    m_size = 0;
+}
+
+void cave::BitVector::clearUnusedBits(){
+    if (m_size % bitsPerWord != 0){
+        m_words[m_words.size() - 1] &= ~(~uint64_t(0) << (m_size % bitsPerWord));
+    }
+}
+void cave::BitVector::checkSameSize(const cave::BitVector& other) const {
+    if (other.m_size != m_size){
+        throw cave::OutOfRangeException(other.m_size);
+    }
+}
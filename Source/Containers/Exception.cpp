@@ -12,4 +12,11 @@ cave::OutOfRangeException::OutOfRangeException(size_t p) : pos(p) {
 }
 cave::OutOfRangeException::~OutOfRangeException(){
     
+}
+
+cave::FormatException::FormatException(const char* msg) : message(msg) {
+
+}
+cave::FormatException::~FormatException(){
+    
 }
\ No newline at end of file
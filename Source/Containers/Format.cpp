@@ -0,0 +1,224 @@
+#include "Containers/Format.h"
+
+#include <charconv> // std::to_chars
+#include <cstring>  // memcpy, memset
+#include <cstdio>   // snprintf
+
+#include "Containers/StringNumbers.h"
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable : 4996) // snprintf and others...
+#endif
+
+
+void cave::FormatOutput::writeFill(char c, size_t count){
+    char chunk[32];
+    memset(chunk, c, sizeof(chunk));
+    while (count > 0){
+        const size_t n = count < sizeof(chunk) ? count : sizeof(chunk);
+        write(chunk, n);
+        count -= n;
+    }
+}
+
+void cave::FormatOutput::writePadded(cave::StringView str, const cave::FormatSpec& spec, char defaultAlign){
+    if (spec.width <= str.size()){
+        write(str.data(), str.size());
+        return;
+    }
+    const size_t padding = spec.width - str.size();
+    if (spec.zeroPad && spec.align == 0){
+        // Numbers: the zeros go after the sign.
+        const size_t sign = (!str.empty() && (str[0] == '-' || str[0] == '+')) ? 1 : 0;
+        write(str.data(), sign);
+        writeFill('0', padding);
+        write(str.data() + sign, str.size() - sign);
+        return;
+    }
+    const char align = spec.align ? spec.align : defaultAlign;
+    const size_t left = align == '>' ? padding : (align == '^' ? padding / 2 : 0);
+    writeFill(spec.fill, left);
+    write(str.data(), str.size());
+    writeFill(spec.fill, padding - left);
+}
+
+namespace {
+    // Counts everything, but only keeps what fits (leaving room for the null terminator).
+    class BufferOutput : public cave::FormatOutput {
+    public:
+        BufferOutput(char* buffer, size_t size) : m_buffer(buffer), m_size(size), m_total(0) {}
+
+        void write(const char* str, size_t size) override {
+            if (m_total + 1 < m_size){
+                const size_t room = m_size - 1 - m_total;
+                memcpy(m_buffer + m_total, str, size < room ? size : room);
+            }
+            m_total += size;
+        }
+        // Null terminates and returns the full size.
+        size_t finish(){
+            if (m_size > 0){
+                m_buffer[m_total < m_size ? m_total : m_size - 1] = '\0';
+            }
+            return m_total;
+        }
+
+    private:
+        char* m_buffer;
+        size_t m_size;
+        size_t m_total;
+    };
+
+    class StringOutput : public cave::FormatOutput {
+    public:
+        explicit StringOutput(cave::String& str) : m_str(str) {}
+
+        void write(const char* str, size_t size) override {
+            m_str.append(str, size);
+        }
+
+    private:
+        cave::String& m_str;
+    };
+
+    template <typename T>
+    void formatIntegerAs(cave::FormatOutput& out, T value, const cave::FormatSpec& spec){
+        if (spec.precision >= 0){
+            cave::formatting::formatError("Integers don't take a precision.");
+        }
+        char buffer[80]; // Enough for 64 bits in binary (and the sign).
+        size_t size = 0;
+        switch (spec.type){
+            case 0:
+            case 'd':
+                size = cave::formatNumber(buffer, value);
+                break;
+            case 'c': {
+                const char c = char(value);
+                out.writePadded(cave::StringView(&c, 1), spec, '<');
+                return;
+            }
+            case 'x':
+            case 'X':
+            case 'b':
+            case 'o': {
+                const int base = spec.type == 'b' ? 2 : (spec.type == 'o' ? 8 : 16);
+                size = size_t(std::to_chars(buffer, buffer + sizeof(buffer), value, base).ptr - buffer);
+                if (spec.type == 'X'){
+                    for (size_t i=0; i<size; i++){
+                        if (buffer[i] >= 'a' && buffer[i] <= 'f'){
+                            buffer[i] = char(buffer[i] - 'a' + 'A');
+                        }
+                    }
+                }
+                break;
+            }
+            default:
+                cave::formatting::formatError("Invalid format type for an integer.");
+        }
+        out.writePadded(cave::StringView(buffer, size), spec, '>');
+    }
+
+    template <typename F>
+    void formatFloatAs(cave::FormatOutput& out, F value, const cave::FormatSpec& spec){
+        char buffer[512];
+        size_t size = 0;
+        if (spec.type == 0 && spec.precision < 0){
+            // The shortest text that reads back to the same value.
+            size = cave::formatNumber(buffer, value);
+        }
+        else if (spec.type == 0 || spec.type == 'f' || spec.type == 'e' || spec.type == 'g'){
+            // (Capped, so even 1e308 in fixed notation fits in the buffer.)
+            const int precision = spec.precision < 0 ? 6 : (spec.precision > 100 ? 100 : spec.precision);
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+            const std::chars_format format = spec.type == 'f' ? std::chars_format::fixed :
+                (spec.type == 'e' ? std::chars_format::scientific : std::chars_format::general);
+            size = size_t(std::to_chars(buffer, buffer + sizeof(buffer), value, format, precision).ptr - buffer);
+#else
+            const char* format = spec.type == 'f' ? "%.*f" : (spec.type == 'e' ? "%.*e" : "%.*g");
+            size = size_t(snprintf(buffer, sizeof(buffer), format, precision, double(value)));
+#endif
+        }
+        else {
+            cave::formatting::formatError("Invalid format type for a float.");
+        }
+        out.writePadded(cave::StringView(buffer, size), spec, '>');
+    }
+}
+
+void cave::formatting::formatError(const char* message){
+    throw cave::FormatException(message);
+}
+
+void cave::formatting::formatInteger(cave::FormatOutput& out, long long value, const cave::FormatSpec& spec){
+    formatIntegerAs(out, value, spec);
+}
+void cave::formatting::formatInteger(cave::FormatOutput& out, unsigned long long value, const cave::FormatSpec& spec){
+    formatIntegerAs(out, value, spec);
+}
+void cave::formatting::formatFloat(cave::FormatOutput& out, float value, const cave::FormatSpec& spec){
+    formatFloatAs(out, value, spec);
+}
+void cave::formatting::formatFloat(cave::FormatOutput& out, double value, const cave::FormatSpec& spec){
+    formatFloatAs(out, value, spec);
+}
+
+void cave::formatting::formatText(cave::FormatOutput& out, cave::StringView value, const cave::FormatSpec& spec){
+    if (spec.type != 0 && spec.type != 's'){
+        formatError("Invalid format type for a text.");
+    }
+    // The precision is the max amount of chars.
+    if (spec.precision >= 0 && size_t(spec.precision) < value.size()){
+        value = value.substr(0, size_t(spec.precision));
+    }
+    out.writePadded(value, spec, '<');
+}
+void cave::formatting::formatCString(cave::FormatOutput& out, const void* value, const cave::FormatSpec& spec){
+    formatText(out, StringView(static_cast<const char*>(value)), spec);
+}
+
+void cave::formatting::formatTo(cave::FormatOutput& out, cave::StringView fmt, const FormatArg* args, size_t count){
+    const size_t fields = parseFormat(fmt.data(), fmt.data() + fmt.size(),
+        [&out](const char* str, size_t size){
+            if (size > 0){
+                out.write(str, size);
+            }
+        },
+        [&out, args, count](size_t index, const FormatSpec& spec){
+            if (index >= count){
+                formatError("The format string has more {} than arguments.");
+            }
+            args[index].format(out, args[index].value, spec);
+        });
+    if (fields != count){
+        formatError("The format string has fewer {} than arguments.");
+    }
+}
+
+cave::String cave::formatting::formatToString(cave::StringView fmt, const FormatArg* args, size_t count){
+    // Most messages fit in the stack buffer and are copied once into the String.
+    // The bigger ones are formatted again, straight into a buffer of their size.
+    char stack[256];
+    BufferOutput buffer(stack, sizeof(stack));
+    formatTo(buffer, fmt, args, count);
+    const size_t size = buffer.finish();
+    if (size < sizeof(stack)){
+        return String(StringView(stack, size));
+    }
+    String result;
+    result.reserve(size);
+    StringOutput output(result);
+    formatTo(output, fmt, args, count);
+    return result;
+}
+
+size_t cave::formatting::formatToBuffer(char* buffer, size_t size, cave::StringView fmt, const FormatArg* args, size_t count){
+    BufferOutput output(buffer, size);
+    formatTo(output, fmt, args, count);
+    return output.finish();
+}
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
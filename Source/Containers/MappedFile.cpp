@@ -0,0 +1,180 @@
+#include "Containers/MappedFile.h"
+
+#ifdef _WIN32
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+
+cave::MappedFile::MappedFile() : m_data(nullptr), m_size(0), m_open(false) {
+#ifdef _WIN32
+    m_file = nullptr;
+    m_mapping = nullptr;
+#endif
+}
+cave::MappedFile::MappedFile(cave::MappedFile&& other) noexcept : m_data(other.m_data), m_size(other.m_size), m_open(other.m_open) {
+#ifdef _WIN32
+    m_file = other.m_file;
+    m_mapping = other.m_mapping;
+    other.m_file = nullptr;
+    other.m_mapping = nullptr;
+#endif
+    other.m_data = nullptr;
+    other.m_size = 0;
+    other.m_open = false;
+}
+cave::MappedFile::~MappedFile(){
+    close();
+}
+
+cave::MappedFile& cave::MappedFile::operator=(cave::MappedFile&& other) noexcept {
+    if (this != &other){
+        close();
+        m_data = other.m_data;
+        m_size = other.m_size;
+        m_open = other.m_open;
+#ifdef _WIN32
+        m_file = other.m_file;
+        m_mapping = other.m_mapping;
+        other.m_file = nullptr;
+        other.m_mapping = nullptr;
+#endif
+        other.m_data = nullptr;
+        other.m_size = 0;
+        other.m_open = false;
+    }
+    return *this;
+}
+
+#ifdef _WIN32
+
+bool cave::MappedFile::open(const char* path, Access hint){
+    close();
+
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, 
+        hint == Access::Sequential ? FILE_FLAG_SEQUENTIAL_SCAN : 
+        hint == Access::Random ? FILE_FLAG_RANDOM_ACCESS : FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE){
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize)){
+        CloseHandle(file);
+        return false;
+    }
+
+    m_file = file;
+    m_size = (size_t)fileSize.QuadPart;
+    m_open = true;
+    if (m_size == 0){
+        return true;
+    }
+
+    m_mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (m_mapping){
+        m_data = MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0);
+    }
+    if (m_data == nullptr){
+        close();
+        return false;
+    }
+    return true;
+}
+
+void cave::MappedFile::close(){
+    if (m_data){
+        UnmapViewOfFile(m_data);
+    }
+    if (m_mapping){
+        CloseHandle((HANDLE)m_mapping);
+    }
+    if (m_file){
+        CloseHandle((HANDLE)m_file);
+    }
+    m_data = nullptr;
+    m_mapping = nullptr;
+    m_file = nullptr;
+    m_size = 0;
+    m_open = false;
+}
+
+void cave::MappedFile::advise(Access hint){
+    // Windows only takes the hints when opening the file.
+    (void)hint;
+}
+
+#else
+
+bool cave::MappedFile::open(const char* path, Access hint){
+    close();
+
+    const int fd = ::open(path, O_RDONLY);
+    if (fd < 0){
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0){
+        ::close(fd);
+        return false;
+    }
+
+    m_size = (size_t)info.st_size;
+    if (m_size > 0){
+        void* ptr = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (ptr == MAP_FAILED){
+            ::close(fd);
+            m_size = 0;
+            return false;
+        }
+        m_data = ptr;
+    }
+    // The mapping keeps its own reference to the file.
+    ::close(fd);
+
+    m_open = true;
+    advise(hint);
+    return true;
+}
+
+void cave::MappedFile::close(){
+    if (m_data){
+        munmap(m_data, m_size);
+    }
+    m_data = nullptr;
+    m_size = 0;
+    m_open = false;
+}
+
+void cave::MappedFile::advise(Access hint){
+    if (m_data == nullptr){
+        return;
+    }
+    int advice = MADV_NORMAL;
+    switch (hint){
+        case Access::Normal:     advice = MADV_NORMAL;     break;
+        case Access::Sequential: advice = MADV_SEQUENTIAL; break;
+        case Access::Random:     advice = MADV_RANDOM;     break;
+        case Access::WillNeed:   advice = MADV_WILLNEED;   break;
+    }
+    madvise(m_data, m_size, advice);
+}
+
+#endif
+
+bool cave::MappedFile::isOpen() const {
+    return m_open;
+}
+
+const void* cave::MappedFile::data() const {
+    return m_data;
+}
+size_t cave::MappedFile::size() const {
+    return m_size;
+}
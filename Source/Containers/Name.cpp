@@ -0,0 +1,153 @@
+#include "Containers/Name.h"
+
+#include <cstdlib> // malloc, calloc, free
+#include <cstring> // memcpy, memcmp
+#include <mutex>
+#include <shared_mutex>
+
+
+namespace {
+    using Entry = cave::Name::Entry;
+
+    // Global table behind cave::Name. The entries live in big arena blocks that
+    // are never freed (so the Names never dangle) and are indexed by an open
+    // addressing (linear probing) hash table of pointers. Lookups only take a
+    // shared lock, so many threads can resolve Names at the same time.
+    class NameTable {
+    public:
+        static constexpr size_t blockSize = 64 * 1024;
+        static constexpr size_t minSlots = 1024;
+
+        NameTable() : m_slots((const Entry**)calloc(minSlots, sizeof(const Entry*))), m_slotCount(minSlots),
+            m_entryCount(0), m_block(nullptr), m_blockUsed(0), m_blockSize(0) {}
+        NameTable(const NameTable&) = delete;
+        NameTable& operator=(const NameTable&) = delete;
+        // Leaked on purpose: it's never destroyed, not even at exit, so Names
+        // stay valid in the destructors of other statics and in threads that
+        // are still running while the program exits. (It stays reachable
+        // through this reference, so the leak checkers don't complain.)
+        static NameTable& instance(){
+            static NameTable& s_table = *new NameTable();
+            return s_table;
+        }
+
+        const Entry* find(const char* str, size_t size, size_t hash){
+            std::shared_lock<std::shared_mutex> lock(m_mutex);
+            return findSlot(str, size, hash);
+        }
+
+        const Entry* intern(const char* str, size_t size, size_t hash){
+            if (const Entry* entry = find(str, size, hash)){
+                return entry;
+            }
+            std::unique_lock<std::shared_mutex> lock(m_mutex);
+            // Another thread may have added it while we were not holding the lock:
+            if (const Entry* entry = findSlot(str, size, hash)){
+                return entry;
+            }
+            // Keeping the load factor at most 50%:
+            if ((m_entryCount + 1) * 2 > m_slotCount){
+                grow();
+            }
+            Entry* entry = allocateEntry(size);
+            entry->hash = hash;
+            entry->id = uint32_t(++m_entryCount);
+            entry->size = uint32_t(size);
+            char* chars = reinterpret_cast<char*>(entry + 1);
+            memcpy(chars, str, size);
+            chars[size] = '\0';
+
+            size_t i = hash & (m_slotCount - 1);
+            while (m_slots[i]){
+                i = (i + 1) & (m_slotCount - 1);
+            }
+            m_slots[i] = entry;
+            return entry;
+        }
+
+        size_t size(){
+            std::shared_lock<std::shared_mutex> lock(m_mutex);
+            return m_entryCount;
+        }
+
+    private:
+        const Entry* findSlot(const char* str, size_t size, size_t hash) const {
+            size_t i = hash & (m_slotCount - 1);
+            while (const Entry* entry = m_slots[i]){
+                if (entry->hash == hash && entry->size == size && memcmp(entry + 1, str, size) == 0){
+                    return entry;
+                }
+                i = (i + 1) & (m_slotCount - 1);
+            }
+            return nullptr;
+        }
+
+        void grow(){
+            const size_t newCount = m_slotCount * 2;
+            const Entry** newSlots = (const Entry**)calloc(newCount, sizeof(const Entry*));
+            for (size_t s=0; s<m_slotCount; s++){
+                if (const Entry* entry = m_slots[s]){
+                    size_t i = entry->hash & (newCount - 1);
+                    while (newSlots[i]){
+                        i = (i + 1) & (newCount - 1);
+                    }
+                    newSlots[i] = entry;
+                }
+            }
+            free(m_slots);
+            m_slots = newSlots;
+            m_slotCount = newCount;
+        }
+
+        // Bump allocation. Huge strings get a block of their own.
+        Entry* allocateEntry(size_t size){
+            const size_t align = alignof(Entry);
+            const size_t bytes = (sizeof(Entry) + size + 1 + align - 1) & ~(align - 1);
+            if (m_block == nullptr || m_blockUsed + bytes > m_blockSize){
+                m_blockSize = bytes > blockSize ? bytes : blockSize;
+                m_block = (char*)malloc(m_blockSize);
+                m_blockUsed = 0;
+            }
+            Entry* entry = reinterpret_cast<Entry*>(m_block + m_blockUsed);
+            m_blockUsed += bytes;
+            return entry;
+        }
+
+        std::shared_mutex m_mutex;
+
+        const Entry** m_slots;
+        size_t m_slotCount;
+        size_t m_entryCount;
+
+        char* m_block;
+        size_t m_blockUsed;
+        size_t m_blockSize;
+    };
+
+    size_t hashChars(cave::StringView str){
+        return std::hash<cave::StringView>()(str);
+    }
+}
+
+cave::Name::Name(const char* str) : Name(StringView(str)) {}
+cave::Name::Name(const cave::String& str) : Name(str.view()) {}
+cave::Name::Name(cave::StringView str) : m_entry(nullptr) {
+    if (!str.empty()){
+        m_entry = NameTable::instance().intern(str.data(), str.size(), hashChars(str));
+    }
+}
+
+cave::Name cave::Name::find(cave::StringView str){
+    if (str.empty()){
+        return Name();
+    }
+    return Name(NameTable::instance().find(str.data(), str.size(), hashChars(str)));
+}
+
+size_t cave::Name::tableSize(){
+    return NameTable::instance().size();
+}
+
+size_t cave::Name::stringHash() const {
+    return m_entry ? m_entry->hash : hashChars(StringView());
+}
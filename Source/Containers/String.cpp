@@ -1,6 +1,7 @@
 #include "Containers/String.h"
 
 #include <cstring>
+#include <utility> // std::move
 #include <stdio.h>
 #include <string.h>
 
@@ -12,38 +13,31 @@
 #endif
 
 
-cave::String::String() : m_data(nullptr), m_size(0), m_allocated(0) {}
-cave::String::String(const char* str) : m_data(nullptr), m_size(0), m_allocated(0) {
-    assign(str);
+cave::String::String() : m_local() {
 }
-cave::String::String(const std::string& other) : m_data(nullptr), m_size(0), m_allocated(0) {
-    assign(other.c_str());
+cave::String::String(const char* str) : String() {
+    assign(str);
 }
-cave::String::String(const cave::String& other) : m_data(nullptr), m_size(0), m_allocated(0) {
-    assign(other);
+cave::String::String(const std::string& other) : String() {
+    assign(other.data(), other.size());
 }
-cave::String::String(cave::String&& other) noexcept : m_data(other.m_data), m_size(other.m_size), m_allocated(other.m_allocated) {
-    other.m_data = nullptr;
-    other.m_size = 0;
-    other.m_allocated = 0;
+cave::String::String(cave::StringView view) : String() {
+    assign(view.data(), view.size());
 }
-cave::String::~String(){
-    if (m_data){
-        free(m_data);
-    }
+cave::String::String(const cave::String& other) : String() {
+    assign(other);
 }
-
 cave::String::iterator cave::String::begin() { 
-    return &at(0); 
+    return buffer(); 
 }
 cave::String::const_iterator cave::String::begin() const { 
-    return &at(0); 
+    return buffer(); 
 }
 cave::String::iterator cave::String::end() { 
-    return &at(m_size); 
+    return buffer() + size(); 
 }
 cave::String::const_iterator cave::String::end() const { 
-    return &at(m_size); 
+    return buffer() + size(); 
 }
 
 char&       cave::String::front() {
@@ -54,24 +48,33 @@ const char& cave::String::front() const {
 }
 
 char&       cave::String::back() {
-    return at(m_size - 1);
+    return at(size() - 1);
 }
 const char& cave::String::back() const {
-    return at(m_size - 1);    
+    return at(size() - 1);    
 }
 
 bool cave::String::operator==(const char* other) const {
-    return compare(other) == 0;
+    return view() == StringView(other);
 }
 bool cave::String::operator==(const cave::String& other) const {
-    return compare(other) == 0;
+    // Different sizes return before touching the chars.
+    return view() == other.view();
+}
+
+bool cave::String::operator==(cave::StringView other) const {
+    return view() == other;
 }
 
 bool cave::String::operator!=(const char* other) const {
-    return compare(other) != 0;
+    return view() != StringView(other);
 }
 bool cave::String::operator!=(const cave::String& other) const {
-    return compare(other) != 0;
+    return view() != other.view();
+}
+
+bool cave::String::operator!=(cave::StringView other) const {
+    return view() != other;
 }
 
 bool cave::String::operator<(const char* other) const {
@@ -116,23 +119,22 @@ cave::String& cave::String::operator=(const cave::String& other) {
 }
 cave::String& cave::String::operator=(cave::String&& other)  {
     if (this != &other){
-        if (m_data){
-            free(m_data);
+        if (!isLocal()){
+            free(m_heap.data);
         }
-        m_data = other.m_data;
-        m_size = other.m_size;
-        m_allocated = other.m_allocated;
-        other.m_data = nullptr;
-        other.m_size = 0;
-        other.m_allocated = 0;
+        m_heap = other.m_heap;
+        other.resetToLocal();
     }
     return *this;
 }
 
+cave::String& cave::String::operator=(cave::StringView view) {
+    assign(view);
+    return *this;
+}
+
 cave::String& cave::String::operator+=(const char str) {
-    reserve(m_size + 1);
-    m_data[m_size++] = str;
-    m_data[m_size] = '\0';
+    append(str);
     return *this;
 }
 cave::String& cave::String::operator+=(const char* str) {
@@ -144,216 +146,385 @@ cave::String& cave::String::operator+=(const cave::String& other) {
     return *this;
 }
 
-cave::String cave::String::operator+(const char str) {
-    String out(*this);
-    out += str;
-    return out;
-}
-cave::String cave::String::operator+(const char* str) {
-    String out(*this);
-    out.append(str);
-    return out;
-}
-cave::String cave::String::operator+(const cave::String& other) {
-    String out(*this);
-    out.append(other);
-    return out;
+cave::String& cave::String::operator+=(cave::StringView view) {
+    append(view);
+    return *this;
 }
 
 char cave::String::operator[](size_t pos) const {
-    return m_data[pos];
+    return buffer()[pos];
 }
 char& cave::String::operator[](size_t pos) {
-    return m_data[pos];
+    return buffer()[pos];
 }
 
 const char* cave::String::c_str() const {
-    if (m_data){
-        return m_data;
-    }
-    return "\0";
+    return buffer();
 }
 const char* cave::String::data() const {
-    return m_data;
+    return buffer();
 }
 
 char& cave::String::at(size_t pos) {
-    if (pos > m_size || m_data == nullptr){
+    if (pos > size()){
         throw cave::OutOfRangeException(pos);
     }
-    return m_data[pos];
+    return buffer()[pos];
 }
 const char& cave::String::at(size_t pos) const {
-    if (pos > m_size || m_data == nullptr){
+    if (pos > size()){
         throw cave::OutOfRangeException(pos);
     }
-    return m_data[pos];
+    return buffer()[pos];
 }
 
 size_t cave::String::size()  const {
-    return m_size;
+    return isLocal() ? localSize() : m_heap.size;
 }
 size_t cave::String::length() const {
-    return m_size;
+    return size();
 }
 bool cave::String::empty() const {
-    return m_size == 0;
+    return size() == 0;
 }
 
 void cave::String::clear() {
-    assign("");
+    setSize(0);
 }
 
 void cave::String::assign(const char* str) {
     if (str){
-        m_size = strlen(str);
-        reserve(m_size);
-        memcpy(m_data, str, m_size * sizeof(char));
-        m_data[m_size] = '\0';
+        assign(str, strlen(str));
     }
     else {
-        assign("");
+        clear();
     }
 }
-void cave::String::assign(const cave::String& other) {
-    if (other.m_size == 0){
-        assign("");
-    }
-    else {
-        assign(other.m_data);
+void cave::String::assign(const char* str, size_t count) {
+    if (count > capacity()){
+        // str may point into this string, so it's copied before freeing anything.
+        String tmp;
+        tmp.reserve(count);
+        memcpy(tmp.buffer(), str, count * sizeof(char));
+        tmp.setSize(count);
+        *this = std::move(tmp);
+        return;
     }
+    memmove(buffer(), str, count * sizeof(char));
+    setSize(count);
+}
+void cave::String::assign(const cave::String& other) {
+    assign(other.view());
+}
+
+void cave::String::assign(cave::StringView view) {
+    assign(view.data(), view.size());
 }
 
 void cave::String::append(const char str) {
-    reserve(m_size + 1);
-    m_data[m_size++] = str;
-    m_data[m_size] = '\0';
+    // Fast paths (the common case): there's room already.
+    if (isLocal()){
+        const size_t size = localSize();
+        if (size < localCapacity){
+            m_local[size] = str;
+            m_local[size + 1] = '\0';
+            m_local[lastByte] = char(size + 1);
+            return;
+        }
+    }
+    else {
+        const size_t size = m_heap.size;
+        if (size < unpackCapacity(m_heap.capacity)){
+            char* data = m_heap.data;
+            data[size] = str;
+            data[size + 1] = '\0';
+            m_heap.size = size + 1;
+            return;
+        }
+    }
+    const size_t size = this->size();
+    reserve(size + 1);
+    m_heap.data[size] = str;
+    setSize(size + 1);
 }
 
 void cave::String::append(const char* str) {
     if (str){
-        const size_t newSize = m_size + strlen(str);
-        reserve(newSize);
-        memcpy((void*)(m_data + m_size), str, (newSize - m_size) * sizeof(char));
-        m_size = newSize;
-        m_data[m_size] = '\0';
+        append(str, strlen(str));
     }
 }
+void cave::String::append(const char* str, size_t count) {
+    // Fast paths (the common case): there's room already.
+    if (isLocal()){
+        const size_t size = localSize();
+        if (count <= localCapacity - size){
+            memmove(m_local + size, str, count * sizeof(char));
+            m_local[size + count] = '\0';
+            m_local[lastByte] = char(size + count);
+            return;
+        }
+    }
+    else {
+        const size_t size = m_heap.size;
+        if (count <= unpackCapacity(m_heap.capacity) - size){
+            char* data = m_heap.data;
+            memmove(data + size, str, count * sizeof(char));
+            data[size + count] = '\0';
+            m_heap.size = size + count;
+            return;
+        }
+    }
+
+    // Appending (a part of) itself: the buffer may move while growing.
+    const StringView chars = view();
+    const bool aliased = str >= chars.data() && str <= chars.data() + chars.size();
+    const size_t offset = aliased ? size_t(str - chars.data()) : 0;
+
+    reserve(chars.size() + count);
+    char* data = m_heap.data;
+    if (aliased){
+        str = data + offset;
+    }
+    memmove((void*)(data + chars.size()), str, count * sizeof(char));
+    data[chars.size() + count] = '\0';
+    m_heap.size = chars.size() + count;
+}
 void cave::String::append(const cave::String& other) {
-    append(other.m_data);
+    append(other.view());
+}
+
+void cave::String::append(cave::StringView view) {
+    append(view.data(), view.size());
 }
 
 void cave::String::pushBack(const char other) {
     append(other);
 }
 void cave::String::popBack() {
-    if (m_size > 0){
-        m_data[--m_size] = '\0';
+    const size_t size = this->size();
+    if (size > 0){
+        setSize(size - 1);
     }
 }
 
 int cave::String::compare(const char* str) const {
-    if (m_data == nullptr){
-        return strcmp("", str);
-    }
-    return strcmp(m_data, str);
+    return view().compare(StringView(str));
 }
 int cave::String::compare(const cave::String& other) const {
-    return compare(other.m_data);
+    return view().compare(other.view());
+}
+
+int cave::String::compare(cave::StringView other) const {
+    return view().compare(other);
+}
+
+bool cave::String::startsWith(cave::StringView prefix) const {
+    return view().startsWith(prefix);
+}
+bool cave::String::endsWith(cave::StringView suffix) const {
+    return view().endsWith(suffix);
+}
+
+bool cave::String::isValidUtf8() const {
+    return utf8::isValid(view());
+}
+
+size_t cave::String::codePointCount() const {
+    return utf8::countCodePoints(view());
+}
+
+cave::utf8::CodePointRange cave::String::codePoints() const {
+    return utf8::CodePointRange(view());
 }
 
 size_t cave::String::find(const char* str,          size_t pos) const {
-    char* found = strstr((char*)(m_data + pos), str);
-    if (found){
-        return (size_t)(found - m_data);
-    }
-    return npos;
+    return view().find(StringView(str), pos);
 }
 size_t cave::String::find(const cave::String& other, size_t pos) const {
-    return find(other.m_data, pos);
+    return view().find(other.view(), pos);
 }
 
-size_t cave::String::rfind(const char* str,           size_t pos) const {
-    if (pos == npos){
-        pos = m_size - 1;
-    }
-    const size_t strSize = strlen(str);
+size_t cave::String::find(cave::StringView view, size_t pos) const {
+    return this->view().find(view, pos);
+}
 
-    for (long long int i=pos; i>=0; i--){
-        if (strncmp(m_data + i, str, strSize) == 0){
-            return i;
-        }
-    }
-    return npos;
+size_t cave::String::rfind(const char* str,           size_t pos) const {
+    return view().rfind(StringView(str), pos);
 }
 size_t cave::String::rfind(const cave::String& other, size_t pos) const {
-    return rfind(other.m_data, pos);
+    return view().rfind(other.view(), pos);
+}
+
+size_t cave::String::rfind(cave::StringView view, size_t pos) const {
+    return this->view().rfind(view, pos);
 }
 
 cave::String cave::String::substr(size_t pos, size_t count) const {
-    if (pos > m_size) {
-        pos = m_size;
+    const size_t size = this->size();
+    if (pos > size) {
+        pos = size;
     }
-    if (count > m_size - pos) {
-        count = m_size - pos;
+    if (count > size - pos) {
+        count = size - pos;
     }
     String result;
-    result.m_size = count;
-    result.reserve(result.m_size);
-    strncpy(result.m_data, m_data + pos, count);
-    result.m_data[result.m_size] = '\0';
+    result.assign(buffer() + pos, count);
     return result;
 }
 
+cave::StringView cave::String::substrView(size_t pos, size_t count) const {
+    return view().substr(pos, count);
+}
+cave::StringView cave::String::trimView() const {
+    return view().trim();
+}
+cave::StringSplitRange cave::String::splitView(char delimiter) const {
+    return view().split(delimiter);
+}
+
 cave::String& cave::String::replace(size_t pos, size_t len, const char* str) {
-    assign(substr(0, pos) + str + substr(pos + len, npos));
+    replaceRange(pos, len, str, str ? strlen(str) : 0);
     return *this;
 }
 cave::String& cave::String::replace(size_t pos, size_t len, const String& str) {
-    assign(substr(0, pos) + str + substr(pos + len, npos));
+    replaceRange(pos, len, str.buffer(), str.size());
+    return *this;
+}
+cave::String& cave::String::replace(size_t pos, size_t len, cave::StringView str) {
+    replaceRange(pos, len, str.data(), str.size());
     return *this;
 }
 
 cave::String& cave::String::insert(size_t pos, const char* str) {
-    assign(substr(0, pos) + str + substr(pos, npos));
+    replaceRange(pos, 0, str, str ? strlen(str) : 0);
     return *this;
 }
 cave::String& cave::String::insert(size_t pos, const String& str) {
-    assign(substr(0, pos) + str + substr(pos, npos));
+    replaceRange(pos, 0, str.buffer(), str.size());
+    return *this;
+}
+cave::String& cave::String::insert(size_t pos, cave::StringView str) {
+    replaceRange(pos, 0, str.data(), str.size());
     return *this;
 }
 
 cave::String& cave::String::erase(size_t pos, size_t len) {
-    if (len == npos || pos + len >= m_size - 1){
-        assign(substr(0, pos));
-    }
-    else {
-        assign(substr(0, pos) + substr(pos + len, npos));
-    }
+    replaceRange(pos, len, nullptr, 0);
     return *this;
 }
 
-void cave::String::reserve(size_t n){
-    if (n < m_allocated){
-        return;
+size_t cave::String::replaceAll(cave::StringView pattern, cave::StringView replacement) {
+    if (pattern.empty()){
+        return 0;
     }
-    if (m_allocated == 0){
-        m_allocated = 1024;
+    if (owns(pattern.data()) || owns(replacement.data())){
+        // They would change while rewriting:
+        const String patternCopy(pattern);
+        const String replacementCopy(replacement);
+        return replaceAll(patternCopy.view(), replacementCopy.view());
     }
-    while (m_allocated <= n){ 
-        m_allocated *= 2; 
+
+    char* data = buffer();
+    const size_t size = this->size();
+    if (replacement.size() <= pattern.size()){
+        // Not growing: writing behind the reading position, in place.
+        size_t read = 0;
+        size_t write = 0;
+        size_t count = 0;
+        for (size_t found = find(pattern); found != npos; found = find(pattern, read)){
+            memmove(data + write, data + read, found - read);
+            write += found - read;
+            memcpy(data + write, replacement.data(), replacement.size());
+            write += replacement.size();
+            read = found + pattern.size();
+            count++;
+        }
+        if (count > 0){
+            memmove(data + write, data + read, size - read);
+            setSize(write + size - read);
+        }
+        return count;
     }
 
-    if (m_data){
-        m_data = (char*)realloc(m_data, m_allocated * sizeof(char));
+    size_t count = 0;
+    for (size_t found = find(pattern); found != npos; found = find(pattern, found + pattern.size())){
+        count++;
+    }
+    if (count == 0){
+        return 0;
+    }
+    String result;
+    result.reserve(size + count * (replacement.size() - pattern.size()));
+    size_t read = 0;
+    for (size_t found = find(pattern); found != npos; found = find(pattern, read)){
+        result.append(data + read, found - read);
+        result.append(replacement);
+        read = found + pattern.size();
+    }
+    result.append(data + read, size - read);
+    *this = std::move(result);
+    return count;
+}
+
+void cave::String::reserve(size_t n){
+    const size_t current = capacity();
+    if (n <= current){
+        return;
+    }
+    // At least doubling, so appending char by char stays amortized O(1).
+    const size_t newCapacity = n > current * 2 ? n : current * 2;
+
+    if (isLocal()){
+        const size_t size = localSize();
+        char* data = (char*)malloc((newCapacity + 1) * sizeof(char));
+        memcpy(data, m_local, (size + 1) * sizeof(char));
+        m_heap.data = data;
+        m_heap.size = size;
     }
     else {
-        m_data = (char*)malloc(m_allocated * sizeof(char));
+        m_heap.data = (char*)realloc(m_heap.data, (newCapacity + 1) * sizeof(char));
     }
+    m_heap.capacity = packCapacity(newCapacity);
 }
 
 size_t cave::String::capacity() const{
-    return m_allocated;
+    return isLocal() ? localCapacity : unpackCapacity(m_heap.capacity);
+}
+
+cave::String cave::String::concat(cave::StringView lStr, cave::StringView rStr){
+    String out;
+    out.reserve(lStr.size() + rStr.size());
+    char* data = out.buffer();
+    memcpy(data, lStr.data(), lStr.size() * sizeof(char));
+    memcpy(data + lStr.size(), rStr.data(), rStr.size() * sizeof(char));
+    out.setSize(lStr.size() + rStr.size());
+    return out;
+}
+
+void cave::String::replaceRange(size_t pos, size_t len, const char* str, size_t count){
+    const size_t size = this->size();
+    if (pos > size){
+        pos = size;
+    }
+    if (len > size - pos){
+        len = size - pos;
+    }
+    if (count > 0 && owns(str)){
+        // Replacing with (a part of) itself: the chars would move under our feet.
+        const String copy(StringView(str, count));
+        replaceRange(pos, len, copy.buffer(), count);
+        return;
+    }
+
+    const size_t newSize = size - len + count;
+    reserve(newSize);
+    // Moving the tail (and the null terminator) to its final place:
+    char* data = buffer();
+    memmove(data + pos + count, data + pos + len, (size - pos - len + 1) * sizeof(char));
+    if (count > 0){
+        memcpy(data + pos, str, count * sizeof(char));
+    }
+    setSize(newSize);
 }
 
 #ifdef _MSC_VER
@@ -0,0 +1,273 @@
+#include "Containers/StringNumbers.h"
+
+#include <charconv> // std::to_chars, std::from_chars
+#include <cstring>  // memcpy
+#include <type_traits>
+
+#include "Containers/String.h"
+#include "Containers/Vector.h"
+
+#include <cerrno>  // errno
+#include <clocale> // localeconv
+#include <cmath>   // std::isnan, std::isinf
+#include <cstdlib> // strtod, strtof, strtold
+
+// Floats in <charconv> came later than the integers in some standard libraries.
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    #define CAVE_FLOAT_CHARCONV 1
+#else
+    #include <cstdio>  // snprintf
+    #include <limits>
+#endif
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable : 4996) // snprintf and others...
+#endif
+
+
+namespace {
+    // Two digits per division (and per store).
+    const char s_digitPairs[] =
+        "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+        "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+        "8081828384858687888990919293949596979899";
+
+    template <typename U>
+    unsigned int digitCount(U value){
+        unsigned int count = 1;
+        for (;;){
+            if (value < 10)    { return count; }
+            if (value < 100)   { return count + 1; }
+            if (value < 1000)  { return count + 2; }
+            if (value < 10000) { return count + 3; }
+            value /= 10000u;
+            count += 4;
+        }
+    }
+
+    template <typename U>
+    size_t formatUnsigned(char* buffer, U value){
+        const unsigned int count = digitCount(value);
+        char* p = buffer + count;
+        while (value >= 100){
+            const size_t pair = size_t(value % 100) * 2;
+            value /= 100;
+            p -= 2;
+            memcpy(p, s_digitPairs + pair, 2);
+        }
+        if (value >= 10){
+            memcpy(p - 2, s_digitPairs + size_t(value) * 2, 2);
+        }
+        else {
+            p[-1] = char('0' + value);
+        }
+        return count;
+    }
+
+    template <typename S>
+    size_t formatSigned(char* buffer, S value){
+        using U = typename std::make_unsigned<S>::type;
+        if (value < 0){
+            buffer[0] = '-';
+            // Negating as unsigned, so the smallest value doesn't overflow.
+            return 1 + formatUnsigned(buffer + 1, U(U(0) - U(value)));
+        }
+        return formatUnsigned(buffer, U(value));
+    }
+
+    // The decimal point of the current C locale, which strtod and snprintf
+    // use instead of '.' (a ',' in many languages).
+    char localeDecimalPoint(){
+        const char* point = localeconv()->decimal_point;
+        return (point != nullptr && point[0] != '\0') ? point[0] : '.';
+    }
+
+    template <typename F>
+    size_t formatFloat(char* buffer, F value){
+#if defined(CAVE_FLOAT_CHARCONV)
+        // Shortest round trip (the standard libraries use Ryu or similar).
+        return size_t(std::to_chars(buffer, buffer + cave::maxNumberChars, value).ptr - buffer);
+#else
+        if (std::isnan(value)){
+            memcpy(buffer, "nan", 3);
+            return 3;
+        }
+        if (std::isinf(value)){
+            memcpy(buffer, value < 0 ? "-inf" : "inf", value < 0 ? 4 : 3);
+            return value < 0 ? 4 : 3;
+        }
+        // The fewest digits that read back to the same value.
+        char tmp[cave::maxNumberChars + 8];
+        int count = 0;
+        for (int precision = 1; precision <= std::numeric_limits<F>::max_digits10; precision++){
+            if constexpr (std::is_same<F, long double>::value){
+                count = snprintf(tmp, sizeof(tmp), "%.*Lg", precision, value);
+                if (strtold(tmp, nullptr) == value){
+                    break;
+                }
+            }
+            else {
+                count = snprintf(tmp, sizeof(tmp), "%.*g", precision, double(value));
+                if (F(strtod(tmp, nullptr)) == value){
+                    break;
+                }
+            }
+        }
+        // Always a '.', whatever the C locale is (like to_chars).
+        const char point = localeDecimalPoint();
+        for (int i=0; i<count; i++){
+            if (tmp[i] == point){
+                tmp[i] = '.';
+            }
+        }
+        memcpy(buffer, tmp, size_t(count));
+        return size_t(count);
+#endif
+    }
+
+    // Skips the '+' that from_chars doesn't accept (but a "+-1" is still wrong).
+    const char* skipPlus(const char* first, const char* last){
+        if (first != last && *first == '+'){
+            first++;
+            if (first == last || *first == '-'){
+                return nullptr;
+            }
+        }
+        return first;
+    }
+
+    template <typename T>
+    bool parseInteger(cave::StringView str, T& out){
+        const char* last = str.data() + str.size();
+        const char* first = skipPlus(str.data(), last);
+        if (first == nullptr){
+            return false;
+        }
+        T value;
+        const std::from_chars_result result = std::from_chars(first, last, value);
+        if (result.ec != std::errc() || result.ptr != last){
+            return false;
+        }
+        out = value;
+        return true;
+    }
+
+    // For when there's no <charconv> for floats (and for long doubles, whose
+    // from_chars is a strtold call anyway in some libraries, and rejects the
+    // denormals in others). Like from_chars, it only takes a '.' as the
+    // decimal point, whatever the C locale is.
+    template <typename F>
+    bool parseWithStrtod(const char* first, const char* last, F& out){
+        // (strtod skips white spaces.)
+        const size_t size = size_t(last - first);
+        if (size == 0 || *first == ' ' || (*first >= '\t' && *first <= '\r')){
+            return false;
+        }
+        const char point = localeDecimalPoint();
+        for (const char* it = first; it != last; ++it){
+            if (*it == 'x' || *it == 'X' || (*it == point && point != '.')){
+                return false; // No hex floats (like from_chars), nor the locale's decimal point.
+            }
+        }
+        // strtod wants a null terminated string, with the locale's decimal point.
+        // Almost every number fits in the stack buffer.
+        char stack[128];
+        cave::Vector<char> heap;
+        char* tmp = stack;
+        if (size >= sizeof(stack)){
+            heap.resize(size + 1);
+            tmp = heap.data();
+        }
+        memcpy(tmp, first, size);
+        tmp[size] = '\0';
+        if (point != '.'){
+            for (size_t i=0; i<size; i++){
+                if (tmp[i] == '.'){
+                    tmp[i] = point;
+                }
+            }
+        }
+        char* end = nullptr;
+        errno = 0;
+        F value;
+        if constexpr (std::is_same<F, float>::value){
+            value = strtof(tmp, &end);
+        }
+        else if constexpr (std::is_same<F, double>::value){
+            value = strtod(tmp, &end);
+        }
+        else {
+            value = strtold(tmp, &end);
+        }
+        // (ERANGE is also set for denormals, which are fine.)
+        if (end != tmp + size || (errno == ERANGE && (std::isinf(value) || value == 0))){
+            return false;
+        }
+        out = value;
+        return true;
+    }
+
+    template <typename F>
+    bool parseFloat(cave::StringView str, F& out){
+        const char* last = str.data() + str.size();
+        const char* first = skipPlus(str.data(), last);
+        if (first == nullptr){
+            return false;
+        }
+#if defined(CAVE_FLOAT_CHARCONV)
+        if constexpr (!std::is_same<F, long double>::value){
+            F value;
+            const std::from_chars_result result = std::from_chars(first, last, value);
+            if (result.ec != std::errc() || result.ptr != last){
+                return false;
+            }
+            out = value;
+            return true;
+        }
+#endif
+        return parseWithStrtod(first, last, out);
+    }
+}
+
+size_t cave::formatNumber(char* buffer, int value)                { return formatSigned(buffer, value); }
+size_t cave::formatNumber(char* buffer, unsigned int value)       { return formatUnsigned(buffer, value); }
+size_t cave::formatNumber(char* buffer, long value)               { return formatSigned(buffer, value); }
+size_t cave::formatNumber(char* buffer, unsigned long value)      { return formatUnsigned(buffer, value); }
+size_t cave::formatNumber(char* buffer, long long value)          { return formatSigned(buffer, value); }
+size_t cave::formatNumber(char* buffer, unsigned long long value) { return formatUnsigned(buffer, value); }
+size_t cave::formatNumber(char* buffer, float value)              { return formatFloat(buffer, value); }
+size_t cave::formatNumber(char* buffer, double value)             { return formatFloat(buffer, value); }
+size_t cave::formatNumber(char* buffer, long double value)        { return formatFloat(buffer, value); }
+
+namespace {
+    template <typename T>
+    void appendFormatted(cave::String& str, T value){
+        char buffer[cave::maxNumberChars];
+        str.append(buffer, cave::formatNumber(buffer, value));
+    }
+}
+
+void cave::appendNumber(cave::String& str, int value)                { appendFormatted(str, value); }
+void cave::appendNumber(cave::String& str, unsigned int value)       { appendFormatted(str, value); }
+void cave::appendNumber(cave::String& str, long value)               { appendFormatted(str, value); }
+void cave::appendNumber(cave::String& str, unsigned long value)      { appendFormatted(str, value); }
+void cave::appendNumber(cave::String& str, long long value)          { appendFormatted(str, value); }
+void cave::appendNumber(cave::String& str, unsigned long long value) { appendFormatted(str, value); }
+void cave::appendNumber(cave::String& str, float value)              { appendFormatted(str, value); }
+void cave::appendNumber(cave::String& str, double value)             { appendFormatted(str, value); }
+void cave::appendNumber(cave::String& str, long double value)        { appendFormatted(str, value); }
+
+bool cave::parseNumber(cave::StringView str, int& out)                { return parseInteger(str, out); }
+bool cave::parseNumber(cave::StringView str, unsigned int& out)       { return parseInteger(str, out); }
+bool cave::parseNumber(cave::StringView str, long& out)               { return parseInteger(str, out); }
+bool cave::parseNumber(cave::StringView str, unsigned long& out)      { return parseInteger(str, out); }
+bool cave::parseNumber(cave::StringView str, long long& out)          { return parseInteger(str, out); }
+bool cave::parseNumber(cave::StringView str, unsigned long long& out) { return parseInteger(str, out); }
+bool cave::parseNumber(cave::StringView str, float& out)              { return parseFloat(str, out); }
+bool cave::parseNumber(cave::StringView str, double& out)             { return parseFloat(str, out); }
+bool cave::parseNumber(cave::StringView str, long double& out)        { return parseFloat(str, out); }
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
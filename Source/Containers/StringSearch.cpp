@@ -0,0 +1,227 @@
+#include "Containers/StringSearch.h"
+
+#include <cstring> // memchr, memcmp
+#include <cstddef> // std::ptrdiff_t
+
+#include "Containers/Simd.h"
+
+
+namespace {
+    // The chars read forwards or backwards, so searching backwards is just a
+    // search over the reversed strings.
+    template <bool Reverse>
+    struct Chars {
+        Chars(const char* data, std::ptrdiff_t size) : m_data((const unsigned char*)data), m_size(size) {}
+
+        unsigned char operator[](std::ptrdiff_t i) const {
+            return Reverse ? m_data[m_size - 1 - i] : m_data[i];
+        }
+
+        const unsigned char* m_data;
+        std::ptrdiff_t m_size;
+    };
+
+    // Start of the maximal suffix of x (minus one) and its period, for the normal
+    // or the inverted alphabet order. From Crochemore & Perrin.
+    template <bool Reverse>
+    std::ptrdiff_t maxSuffix(const Chars<Reverse>& x, std::ptrdiff_t m, bool inverted, std::ptrdiff_t& period){
+        std::ptrdiff_t ms = -1;
+        std::ptrdiff_t j = 0;
+        std::ptrdiff_t k = 1;
+        period = 1;
+        while (j + k < m){
+            const unsigned char a = x[j + k];
+            const unsigned char b = x[ms + k];
+            if (inverted ? a > b : a < b){
+                j += k;
+                k = 1;
+                period = j - ms;
+            }
+            else if (a == b){
+                if (k != period){
+                    k++;
+                }
+                else {
+                    j += period;
+                    k = 1;
+                }
+            }
+            else {
+                ms = j;
+                j = ms + 1;
+                k = period = 1;
+            }
+        }
+        return ms;
+    }
+
+    // Two-Way string matching (Crochemore & Perrin): linear time and constant
+    // memory. Index of the first match of x (size m) in y (size n), or -1.
+    template <bool Reverse>
+    std::ptrdiff_t twoWay(const Chars<Reverse>& y, std::ptrdiff_t n, const Chars<Reverse>& x, std::ptrdiff_t m){
+        std::ptrdiff_t p = 0;
+        std::ptrdiff_t q = 0;
+        const std::ptrdiff_t i0 = maxSuffix(x, m, false, p);
+        const std::ptrdiff_t j0 = maxSuffix(x, m, true, q);
+        // Critical factorization: x = x[0..ell] + x[ell+1..m).
+        const std::ptrdiff_t ell = i0 > j0 ? i0 : j0;
+        std::ptrdiff_t per = i0 > j0 ? p : q;
+
+        // Is the left part a suffix of its period? (x[0..ell] == x[per..per+ell])
+        bool periodic = true;
+        for (std::ptrdiff_t i=0; i<=ell; i++){
+            if (i + per >= m || x[i] != x[i + per]){
+                periodic = false;
+                break;
+            }
+        }
+
+        std::ptrdiff_t j = 0;
+        if (periodic){
+            // How much of the left part is known to match after a period shift:
+            std::ptrdiff_t memory = -1;
+            while (j <= n - m){
+                std::ptrdiff_t i = (ell > memory ? ell : memory) + 1;
+                while (i < m && x[i] == y[i + j]){
+                    i++;
+                }
+                if (i >= m){
+                    i = ell;
+                    while (i > memory && x[i] == y[i + j]){
+                        i--;
+                    }
+                    if (i <= memory){
+                        return j;
+                    }
+                    j += per;
+                    memory = m - per - 1;
+                }
+                else {
+                    j += i - ell;
+                    memory = -1;
+                }
+            }
+        }
+        else {
+            per = (ell + 1 > m - ell - 1 ? ell + 1 : m - ell - 1) + 1;
+            while (j <= n - m){
+                std::ptrdiff_t i = ell + 1;
+                while (i < m && x[i] == y[i + j]){
+                    i++;
+                }
+                if (i >= m){
+                    i = ell;
+                    while (i >= 0 && x[i] == y[i + j]){
+                        i--;
+                    }
+                    if (i < 0){
+                        return j;
+                    }
+                    j += per;
+                }
+                else {
+                    j += i - ell;
+                }
+            }
+        }
+        return -1;
+    }
+
+    // First match starting at start or after it.
+    size_t twoWayFind(const char* text, size_t n, const char* needle, size_t m, size_t start){
+        if (n - start < m){
+            return cave::strings::npos;
+        }
+        const std::ptrdiff_t found = twoWay(Chars<false>(text + start, n - start), n - start, Chars<false>(needle, m), m);
+        return found < 0 ? cave::strings::npos : start + size_t(found);
+    }
+
+    // Last match starting before count.
+    size_t twoWayFindLast(const char* text, const char* needle, size_t m, size_t count){
+        if (count == 0){
+            return cave::strings::npos;
+        }
+        const std::ptrdiff_t n = std::ptrdiff_t(count + m - 1);
+        const std::ptrdiff_t found = twoWay(Chars<true>(text, n), n, Chars<true>(needle, m), m);
+        return found < 0 ? cave::strings::npos : size_t(n - found - std::ptrdiff_t(m));
+    }
+
+#if defined(CAVE_SIMD_SSE2)
+    // Once the chars compared by the filter candidates go over this, the filter
+    // isn't helping (the text is too repetitive) and Two-Way takes over.
+    inline bool filterGaveUp(size_t compared, size_t scanned){
+        return compared > 4 * scanned + 256;
+    }
+#endif
+}
+
+size_t cave::strings::findSubstring(const char* text, size_t n, const char* needle, size_t m){
+    if (m == 0){
+        return 0;
+    }
+    if (m > n){
+        return npos;
+    }
+    if (m == 1){
+        const void* found = memchr(text, needle[0], n);
+        return found ? size_t((const char*)found - text) : npos;
+    }
+
+    size_t i = 0;
+#if defined(CAVE_SIMD_SSE2)
+    const simd::Register first = simd::splat(needle[0]);
+    const simd::Register last = simd::splat(needle[m - 1]);
+    size_t compared = 0;
+
+    for (; i + m - 1 + simd::registerSize <= n; i += simd::registerSize){
+        simd::Mask mask = simd::equalMask(text + i, first) & simd::equalMask(text + i + m - 1, last);
+        while (mask){
+            const size_t pos = i + simd::countTrailingZeros(mask);
+            if (memcmp(text + pos + 1, needle + 1, m - 2) == 0){
+                return pos;
+            }
+            compared += m;
+            if (filterGaveUp(compared, i + simd::registerSize)){
+                return twoWayFind(text, n, needle, m, pos + 1);
+            }
+            mask &= mask - 1;
+        }
+    }
+#endif
+    return twoWayFind(text, n, needle, m, i);
+}
+
+size_t cave::strings::rfindSubstring(const char* text, size_t n, const char* needle, size_t m){
+    if (m == 0){
+        return n;
+    }
+    if (m > n){
+        return npos;
+    }
+
+    // The candidates still to check are [0, count).
+    size_t count = n - m + 1;
+#if defined(CAVE_SIMD_SSE2)
+    const simd::Register first = simd::splat(needle[0]);
+    const simd::Register last = simd::splat(needle[m - 1]);
+    size_t compared = 0;
+
+    for (; count >= simd::registerSize; count -= simd::registerSize){
+        const size_t j = count - simd::registerSize;
+        simd::Mask mask = simd::equalMask(text + j, first) & simd::equalMask(text + j + m - 1, last);
+        while (mask){
+            const unsigned int bit = simd::highestBit(mask);
+            const size_t pos = j + bit;
+            if (memcmp(text + pos + 1, needle + 1, m - 1) == 0){
+                return pos;
+            }
+            compared += m;
+            if (filterGaveUp(compared, n - j)){
+                return twoWayFindLast(text, needle, m, pos);
+            }
+            mask &= ~(simd::Mask(1) << bit);
+        }
+    }
+#endif
+    return twoWayFindLast(text, needle, m, count);
+}
@@ -0,0 +1,147 @@
+#include "Containers/ThreadPool.h"
+
+
+namespace {
+    // Set while a thread is running pool tasks, so nested parallelFor calls
+    // don't deadlock waiting for workers that are busy with the outer one.
+    thread_local bool t_insideTask = false;
+}
+
+cave::ThreadPool::ThreadPool(size_t threadCount) : m_threads(nullptr), m_threadCount(threadCount),
+    m_task(nullptr), m_taskCount(0), m_nextTask(0), m_finishedTasks(0), m_generation(0), 
+    m_activeWorkers(0), m_failed(false), m_stop(false) {
+
+    if (m_threadCount == 0){
+        const size_t hw = std::thread::hardware_concurrency();
+        m_threadCount = hw > 1 ? hw - 1 : 0;
+    }
+    if (m_threadCount > 0){
+        m_threads = new std::thread[m_threadCount];
+        for (size_t i=0; i<m_threadCount; i++){
+            m_threads[i] = std::thread(&ThreadPool::workerLoop, this);
+        }
+    }
+}
+
+cave::ThreadPool::~ThreadPool(){
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wakeUp.notify_all();
+
+    for (size_t i=0; i<m_threadCount; i++){
+        m_threads[i].join();
+    }
+    delete[] m_threads;
+}
+
+void cave::ThreadPool::parallelFor(size_t count, const std::function<void(size_t)>& task){
+    if (count == 0){
+        return;
+    }
+    // (Only tried last: a nested call already owns it.)
+    std::unique_lock<std::mutex> runLock(m_runMutex, std::defer_lock);
+    if (t_insideTask || m_threadCount == 0 || count == 1 || !runLock.try_lock()){
+        for (size_t i=0; i<count; i++){
+            task(i);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_task = &task;
+        m_taskCount = count;
+        m_nextTask = 0;
+        m_finishedTasks = 0;
+        m_generation++;
+    }
+    m_wakeUp.notify_all();
+
+    runTasks(&task, count);
+
+    std::exception_ptr error;
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_done.wait(lock, [&](){ 
+            return m_finishedTasks.load() == count && m_activeWorkers == 0; 
+        });
+        m_task = nullptr;
+        m_taskCount = 0;
+        error = m_error;
+        m_error = nullptr;
+        m_failed = false;
+    }
+    // Every task is done (or skipped) by now, so it's safe to throw.
+    if (error){
+        std::rethrow_exception(error);
+    }
+}
+
+size_t cave::ThreadPool::threadCount() const {
+    return m_threadCount;
+}
+
+cave::ThreadPool& cave::ThreadPool::shared(){
+    static ThreadPool pool;
+    return pool;
+}
+
+void cave::ThreadPool::workerLoop(){
+    size_t seenGeneration = 0;
+
+    while (true){
+        const std::function<void(size_t)>* task = nullptr;
+        size_t count = 0;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wakeUp.wait(lock, [&](){ return m_stop || m_generation != seenGeneration; });
+            if (m_stop){
+                return;
+            }
+            seenGeneration = m_generation;
+            if (m_task == nullptr){
+                // Woke up too late, the job is already gone.
+                continue;
+            }
+            task = m_task;
+            count = m_taskCount;
+            m_activeWorkers++;
+        }
+
+        runTasks(task, count);
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_activeWorkers--;
+        }
+        m_done.notify_all();
+    }
+}
+
+void cave::ThreadPool::runTasks(const std::function<void(size_t)>* task, size_t count){
+    t_insideTask = true;
+    while (true){
+        const size_t i = m_nextTask.fetch_add(1);
+        if (i >= count){
+            break;
+        }
+        // After a task throws, the remaining ones are skipped (but still
+        // counted, so parallelFor knows when everybody is done).
+        if (!m_failed.load()){
+            try {
+                (*task)(i);
+            }
+            catch (...){
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (!m_error){
+                    m_error = std::current_exception();
+                }
+                m_failed = true;
+            }
+        }
+        m_finishedTasks.fetch_add(1);
+    }
+    t_insideTask = false;
+}
@@ -0,0 +1,355 @@
+#include "Containers/Utf8.h"
+
+#include "Containers/String.h"
+#include "Containers/Simd.h"
+
+
+namespace {
+    using Byte = unsigned char;
+
+    // Decodes the sequence starting at s (s[0] is NOT ascii) and returns its
+    // size, or zero if it's invalid. Only the shortest form is accepted (no
+    // overlongs), and no surrogates or code points above U+10FFFF.
+    size_t decodeSequence(const Byte* s, size_t n, char32_t& codePoint){
+        const Byte b0 = s[0];
+        if (b0 < 0xC2 || b0 > 0xF4){
+            return 0; // A continuation byte, an overlong lead (C0, C1) or too big.
+        }
+        if (b0 < 0xE0){
+            if (n < 2 || (s[1] & 0xC0) != 0x80){
+                return 0;
+            }
+            codePoint = (char32_t(b0 & 0x1F) << 6) | char32_t(s[1] & 0x3F);
+            return 2;
+        }
+        // The second byte has a narrower range for some leads (RFC 3629).
+        Byte low = 0x80;
+        Byte high = 0xBF;
+        switch (b0){
+            case 0xE0: low = 0xA0; break;  // Overlong.
+            case 0xED: high = 0x9F; break; // Surrogates.
+            case 0xF0: low = 0x90; break;  // Overlong.
+            case 0xF4: high = 0x8F; break; // Above U+10FFFF.
+            default: break;
+        }
+        if (n < 2 || s[1] < low || s[1] > high){
+            return 0;
+        }
+        if (b0 < 0xF0){
+            if (n < 3 || (s[2] & 0xC0) != 0x80){
+                return 0;
+            }
+            codePoint = (char32_t(b0 & 0x0F) << 12) | (char32_t(s[1] & 0x3F) << 6) | char32_t(s[2] & 0x3F);
+            return 3;
+        }
+        if (n < 4 || (s[2] & 0xC0) != 0x80 || (s[3] & 0xC0) != 0x80){
+            return 0;
+        }
+        codePoint = (char32_t(b0 & 0x07) << 18) | (char32_t(s[1] & 0x3F) << 12) |
+                    (char32_t(s[2] & 0x3F) << 6) | char32_t(s[3] & 0x3F);
+        return 4;
+    }
+
+    // How many ascii bytes s starts with.
+    size_t asciiRun(const Byte* s, size_t n){
+        size_t i = 0;
+#if defined(CAVE_SIMD_SSE2)
+        // The byte mask is simply the high bit of every byte.
+        for (; i + cave::simd::registerSize <= n; i += cave::simd::registerSize){
+    #if defined(CAVE_SIMD_AVX2)
+            const cave::simd::Mask mask = (cave::simd::Mask)_mm256_movemask_epi8(_mm256_loadu_si256((const __m256i*)(s + i)));
+    #else
+            const cave::simd::Mask mask = (cave::simd::Mask)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)(s + i)));
+    #endif
+            if (mask){
+                return i + cave::simd::countTrailingZeros(mask);
+            }
+        }
+#endif
+        while (i < n && s[i] < 0x80){
+            i++;
+        }
+        return i;
+    }
+
+    // Walks the text calling onAscii(ptr, count) for every run of ascii bytes
+    // and onCodePoint(codePoint) for every other code point. Invalid bytes
+    // return false right away (StopOnError) or become replacementChar.
+    template <bool StopOnError, typename OnAscii, typename OnCodePoint>
+    bool walk(const char* str, size_t n, OnAscii&& onAscii, OnCodePoint&& onCodePoint){
+        const Byte* s = (const Byte*)str;
+        size_t i = 0;
+        while (i < n){
+            const size_t run = asciiRun(s + i, n - i);
+            if (run > 0){
+                onAscii(s + i, run);
+                i += run;
+            }
+            // Everything up to the next ascii byte, one sequence at a time.
+            while (i < n && s[i] >= 0x80){
+                char32_t codePoint = 0;
+                size_t size = decodeSequence(s + i, n - i, codePoint);
+                if (size == 0){
+                    if (StopOnError){
+                        return false;
+                    }
+                    codePoint = cave::utf8::replacementChar;
+                    size = 1;
+                }
+                onCodePoint(codePoint);
+                i += size;
+            }
+        }
+        return true;
+    }
+
+    // Copies n ascii bytes into wider units.
+    template <typename U>
+    void widenAscii(const Byte* s, size_t n, U* out){
+        size_t i = 0;
+#if defined(CAVE_SIMD_SSE2)
+        const __m128i zero = _mm_setzero_si128();
+        for (; i + 16 <= n; i += 16){
+            const __m128i v = _mm_loadu_si128((const __m128i*)(s + i));
+            const __m128i lo = _mm_unpacklo_epi8(v, zero);
+            const __m128i hi = _mm_unpackhi_epi8(v, zero);
+            if constexpr (sizeof(U) == 2){
+                _mm_storeu_si128((__m128i*)(out + i), lo);
+                _mm_storeu_si128((__m128i*)(out + i + 8), hi);
+            }
+            else {
+                _mm_storeu_si128((__m128i*)(out + i), _mm_unpacklo_epi16(lo, zero));
+                _mm_storeu_si128((__m128i*)(out + i + 4), _mm_unpackhi_epi16(lo, zero));
+                _mm_storeu_si128((__m128i*)(out + i + 8), _mm_unpacklo_epi16(hi, zero));
+                _mm_storeu_si128((__m128i*)(out + i + 12), _mm_unpackhi_epi16(hi, zero));
+            }
+        }
+#endif
+        for (; i < n; i++){
+            out[i] = U(s[i]);
+        }
+    }
+
+    // How many ascii units (UTF-16 or UTF-32) s starts with.
+    template <typename U>
+    size_t wideAsciiRun(const U* s, size_t n){
+        size_t i = 0;
+#if defined(CAVE_SIMD_SSE2)
+        static constexpr size_t lanes = 16 / sizeof(U);
+        const __m128i high = sizeof(U) == 2 ? _mm_set1_epi16(short(0xFF80)) : _mm_set1_epi32(int(0xFFFFFF80));
+        const __m128i zero = _mm_setzero_si128();
+        for (; i + lanes <= n; i += lanes){
+            // A unit is ascii if none of its bytes have any of the high bits.
+            const __m128i v = _mm_and_si128(_mm_loadu_si128((const __m128i*)(s + i)), high);
+            const cave::simd::Mask mask = cave::simd::Mask(_mm_movemask_epi8(_mm_cmpeq_epi8(v, zero))) ^ 0xFFFFu;
+            if (mask){
+                return i + cave::simd::countTrailingZeros(mask) / sizeof(U);
+            }
+        }
+#endif
+        while (i < n && s[i] < 0x80){
+            i++;
+        }
+        return i;
+    }
+
+    // Copies n ascii units (UTF-16 or UTF-32) into bytes.
+    template <typename U>
+    void narrowAscii(const U* s, size_t n, char* out){
+        size_t i = 0;
+#if defined(CAVE_SIMD_SSE2)
+        for (; i + 16 <= n; i += 16){
+            const __m128i* src = (const __m128i*)(s + i);
+            __m128i bytes;
+            if constexpr (sizeof(U) == 2){
+                bytes = _mm_packus_epi16(_mm_loadu_si128(src), _mm_loadu_si128(src + 1));
+            }
+            else {
+                // (Everything is below 0x80, so the signed saturation doesn't matter.)
+                const __m128i ab = _mm_packs_epi32(_mm_loadu_si128(src), _mm_loadu_si128(src + 1));
+                const __m128i cd = _mm_packs_epi32(_mm_loadu_si128(src + 2), _mm_loadu_si128(src + 3));
+                bytes = _mm_packus_epi16(ab, cd);
+            }
+            _mm_storeu_si128((__m128i*)(out + i), bytes);
+        }
+#endif
+        for (; i < n; i++){
+            out[i] = char(s[i]);
+        }
+    }
+
+    // Reads one code point, returning how many units it took.
+    size_t readWide(const char16_t* s, size_t n, char32_t& codePoint){
+        const char32_t unit = s[0];
+        if (unit < 0xD800 || unit > 0xDFFF){
+            codePoint = unit;
+            return 1;
+        }
+        if (unit <= 0xDBFF && n >= 2 && s[1] >= 0xDC00 && s[1] <= 0xDFFF){
+            codePoint = 0x10000 + ((unit - 0xD800) << 10) + (char32_t(s[1]) - 0xDC00);
+            return 2;
+        }
+        codePoint = cave::utf8::replacementChar; // An unpaired surrogate.
+        return 1;
+    }
+    size_t readWide(const char32_t* s, size_t, char32_t& codePoint){
+        codePoint = s[0]; // (encode() takes care of the invalid ones.)
+        return 1;
+    }
+
+    size_t encodedSize(char32_t codePoint){
+        if (codePoint < 0x80){
+            return 1;
+        }
+        if (codePoint < 0x800){
+            return 2;
+        }
+        return (codePoint < 0x10000 || codePoint > 0x10FFFF) ? 3 : 4;
+    }
+
+    template <typename U>
+    cave::String fromWide(const U* s, size_t n){
+        // The exact size first, so the String allocates once.
+        size_t total = 0;
+        for (size_t i = 0; i < n;){
+            const size_t run = wideAsciiRun(s + i, n - i);
+            total += run;
+            i += run;
+            if (i < n){
+                char32_t codePoint = 0;
+                i += readWide(s + i, n - i, codePoint);
+                total += encodedSize(codePoint);
+            }
+        }
+
+        cave::String out;
+        out.reserve(total);
+        char chunk[512];
+        size_t used = 0;
+        for (size_t i = 0; i < n;){
+            if (sizeof(chunk) - used <= cave::utf8::maxSequenceSize){
+                out.append(chunk, used);
+                used = 0;
+            }
+            // (Always leaving space for the sequence after the ascii run.)
+            const size_t room = sizeof(chunk) - used - cave::utf8::maxSequenceSize;
+            const size_t run = wideAsciiRun(s + i, (n - i) < room ? (n - i) : room);
+            narrowAscii(s + i, run, chunk + used);
+            used += run;
+            i += run;
+            if (i < n && s[i] >= 0x80){
+                char32_t codePoint = 0;
+                i += readWide(s + i, n - i, codePoint);
+                used += cave::utf8::encode(codePoint, chunk + used);
+            }
+        }
+        out.append(chunk, used);
+        return out;
+    }
+}
+
+bool cave::utf8::isValid(const char* str, size_t size){
+    return walk<true>(str, size, [](const Byte*, size_t){}, [](char32_t){});
+}
+
+size_t cave::utf8::decode(const char* str, size_t size, char32_t& out){
+    const Byte b0 = (Byte)str[0];
+    if (b0 < 0x80){
+        out = b0;
+        return 1;
+    }
+    const size_t length = decodeSequence((const Byte*)str, size, out);
+    if (length == 0){
+        out = replacementChar;
+        return 1;
+    }
+    return length;
+}
+
+size_t cave::utf8::encode(char32_t codePoint, char* buffer){
+    if (codePoint < 0x80){
+        buffer[0] = char(codePoint);
+        return 1;
+    }
+    if (codePoint < 0x800){
+        buffer[0] = char(0xC0 | (codePoint >> 6));
+        buffer[1] = char(0x80 | (codePoint & 0x3F));
+        return 2;
+    }
+    if ((codePoint >= 0xD800 && codePoint <= 0xDFFF) || codePoint > 0x10FFFF){
+        codePoint = replacementChar;
+    }
+    if (codePoint < 0x10000){
+        buffer[0] = char(0xE0 | (codePoint >> 12));
+        buffer[1] = char(0x80 | ((codePoint >> 6) & 0x3F));
+        buffer[2] = char(0x80 | (codePoint & 0x3F));
+        return 3;
+    }
+    buffer[0] = char(0xF0 | (codePoint >> 18));
+    buffer[1] = char(0x80 | ((codePoint >> 12) & 0x3F));
+    buffer[2] = char(0x80 | ((codePoint >> 6) & 0x3F));
+    buffer[3] = char(0x80 | (codePoint & 0x3F));
+    return 4;
+}
+
+void cave::utf8::appendCodePoint(cave::String& str, char32_t codePoint){
+    char buffer[maxSequenceSize];
+    str.append(buffer, encode(codePoint, buffer));
+}
+
+size_t cave::utf8::countCodePoints(const char* str, size_t size){
+    size_t count = 0;
+    walk<false>(str, size,
+        [&count](const Byte*, size_t run){ count += run; },
+        [&count](char32_t){ count++; });
+    return count;
+}
+
+size_t cave::utf8::utf16Length(const char* str, size_t size){
+    size_t count = 0;
+    walk<false>(str, size,
+        [&count](const Byte*, size_t run){ count += run; },
+        [&count](char32_t codePoint){ count += codePoint >= 0x10000 ? 2 : 1; });
+    return count;
+}
+
+size_t cave::utf8::toUtf16(const char* str, size_t size, char16_t* out){
+    char16_t* first = out;
+    walk<false>(str, size,
+        [&out](const Byte* s, size_t run){
+            widenAscii(s, run, out);
+            out += run;
+        },
+        [&out](char32_t codePoint){
+            if (codePoint >= 0x10000){
+                codePoint -= 0x10000;
+                *out++ = char16_t(0xD800 + (codePoint >> 10));
+                *out++ = char16_t(0xDC00 + (codePoint & 0x3FF));
+            }
+            else {
+                *out++ = char16_t(codePoint);
+            }
+        });
+    return size_t(out - first);
+}
+
+size_t cave::utf8::toUtf32(const char* str, size_t size, char32_t* out){
+    char32_t* first = out;
+    walk<false>(str, size,
+        [&out](const Byte* s, size_t run){
+            widenAscii(s, run, out);
+            out += run;
+        },
+        [&out](char32_t codePoint){
+            *out++ = codePoint;
+        });
+    return size_t(out - first);
+}
+
+cave::String cave::utf8::fromUtf16(const char16_t* str, size_t size){
+    return fromWide(str, size);
+}
+
+cave::String cave::utf8::fromUtf32(const char32_t* str, size_t size){
+    return fromWide(str, size);
+}
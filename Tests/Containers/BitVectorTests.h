@@ -0,0 +1,202 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+
+#include "Containers/BitVector.h"
+#include "Containers/Exception.h"
+
+
+void testCaveBitVector() {
+    std::cout << "[BIT VECTOR] Running tests...\n";
+
+    cave::BitVector bits;
+    assert(bits.empty());
+    assert(bits.count() == 0);
+    assert(bits.none());
+    assert(bits.findFirst() == bits.npos);
+
+    // Test pushBack, test and the word packing
+    for (size_t i=0; i<200; i++){
+        bits.pushBack(i % 3 == 0);
+    }
+    assert(bits.size() == 200);
+    assert(bits.wordCount() == 4);
+    for (size_t i=0; i<200; i++){
+        assert(bits.test(i) == (i % 3 == 0));
+    }
+    assert(bits.count() == 67);
+    try {
+        bits.at(200);
+        assert(false);
+    } catch (cave::OutOfRangeException&) {
+        assert(true);
+    }
+
+    // Test set, reset and flip
+    bits.set(1);
+    assert(bits[1]);
+    bits.set(1, false);
+    assert(!bits[1]);
+    bits.flip(2);
+    assert(bits[2]);
+    bits.reset(2);
+    assert(!bits[2]);
+    assert(bits.count() == 67);
+
+    // Test findFirst and findNext (including whole empty words)
+    {
+        cave::BitVector sparse(1000);
+        sparse.set(5);
+        sparse.set(63);
+        sparse.set(64);
+        sparse.set(700);
+        sparse.set(999);
+
+        size_t expected[] = {5, 63, 64, 700, 999};
+        size_t n = 0;
+        for (size_t i = sparse.findFirst(); i != sparse.npos; i = sparse.findNext(i)){
+            assert(i == expected[n++]);
+        }
+        assert(n == 5);
+        assert(sparse.findNext(999) == sparse.npos);
+
+        cave::BitVector late(5000);
+        late.set(4321);
+        assert(late.findFirst() == 4321);
+        assert(late.any());
+    }
+
+    // Test resize, setAll, flipAll and all (the unused bits must stay clear)
+    {
+        cave::BitVector b(70, true);
+        assert(b.count() == 70);
+        assert(b.all());
+        b.resize(130, true);
+        assert(b.count() == 130);
+        b.resize(200);
+        assert(b.count() == 130);
+        assert(!b[150]);
+        b.resize(65);
+        assert(b.count() == 65);
+        b.resize(100);
+        assert(b.count() == 65);
+
+        b.flipAll();
+        assert(b.count() == 35);
+        assert(b.findFirst() == 65);
+        b.setAll(false);
+        assert(b.none());
+        b.setAll();
+        assert(b.count() == 100);
+
+        b.popBack();
+        assert(b.size() == 99 && b.count() == 99);
+        b.clear();
+        assert(b.empty() && b.count() == 0);
+    }
+
+    // Test the bulk operations
+    {
+        const size_t n = 1000;
+        cave::BitVector a(n);
+        cave::BitVector b(n);
+        for (size_t i=0; i<n; i++){
+            a.set(i, i % 2 == 0);
+            b.set(i, i % 3 == 0);
+        }
+
+        cave::BitVector r = a;
+        r &= b;
+        for (size_t i=0; i<n; i++){ assert(r[i] == (i % 6 == 0)); }
+        r = a;
+        r |= b;
+        for (size_t i=0; i<n; i++){ assert(r[i] == (i % 2 == 0 || i % 3 == 0)); }
+        r = a;
+        r ^= b;
+        for (size_t i=0; i<n; i++){ assert(r[i] == ((i % 2 == 0) != (i % 3 == 0))); }
+        r = a;
+        r.andNot(b);
+        for (size_t i=0; i<n; i++){ assert(r[i] == (i % 2 == 0 && i % 3 != 0)); }
+
+        assert(r != a);
+        r = a;
+        assert(r == a);
+
+        cave::BitVector other(n + 1);
+        try {
+            r &= other;
+            assert(false);
+        } catch (cave::OutOfRangeException&) {
+            assert(true);
+        }
+    }
+
+    std::cout << "[BIT VECTOR] All tests passed!" << std::endl;
+}
+
+// Performance checks...
+
+#include <cstdio>
+#include <chrono>
+
+#include "Containers/Vector.h"
+
+void testBitVectorPerformance() {
+    const size_t N = 4000000;
+
+    std::cout << " - (Combining two masks of " << N << " flags.)\n";
+
+    cave::Vector<bool> v1;
+    cave::Vector<bool> v2;
+    v1.resize(N);
+    v2.resize(N);
+    cave::BitVector b1(N);
+    cave::BitVector b2(N);
+    uint64_t seed = 42;
+    for (size_t i = 0; i < N; i++) {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        const bool x = (seed >> 40) & 1;
+        const bool y = (seed >> 41) & 1;
+        v1[i] = x;
+        v2[i] = y;
+        b1.set(i, x);
+        b2.set(i, y);
+    }
+
+    printf("          | Vector<bool> |   BitVector  |\n");
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < N; i++) {
+        v1[i] = v1[i] && v2[i];
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    size_t dur1 = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+    start = std::chrono::high_resolution_clock::now();
+    b1 &= b2;
+    end = std::chrono::high_resolution_clock::now();
+    size_t dur2 = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    printf("      AND | %9zu us | %9zu us |", dur1, dur2);
+    if (dur1 < dur2){ printf(" BAD!"); }
+    printf("\n");
+
+    size_t count1 = 0;
+    start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < N; i++) {
+        count1 += v1[i];
+    }
+    end = std::chrono::high_resolution_clock::now();
+    dur1 = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+    start = std::chrono::high_resolution_clock::now();
+    size_t count2 = b1.count();
+    end = std::chrono::high_resolution_clock::now();
+    dur2 = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    printf("    Count | %9zu us | %9zu us |", dur1, dur2);
+    if (dur1 < dur2){ printf(" BAD!"); }
+    printf("\n");
+
+    assert(count1 == count2); // Little assert just to make sure...
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cassert>
+#include <iostream>
+
+#include "Containers/CompactVector.h"
+#include "Containers/Vector.h"
+#include "Containers/String.h"
+#include "Containers/Exception.h"
+
+
+void testCaveCompactVector() {
+    std::cout << "[COMPACT VECTOR] Running tests...\n";
+
+    // The whole point of it:
+    static_assert(sizeof(cave::CompactVector<int>) == sizeof(void*) + 2 * sizeof(uint32_t), "CompactVector must be 16 bytes.");
+    static_assert(!std::is_polymorphic<cave::CompactVector<int>>::value, "CompactVector must not have a vtable.");
+#ifdef CAVE_CONTAINERS_NO_VTABLE
+    static_assert(!std::is_polymorphic<cave::Vector<int>>::value, "CAVE_CONTAINERS_NO_VTABLE must remove the vtable.");
+    static_assert(!std::is_polymorphic<cave::String>::value, "CAVE_CONTAINERS_NO_VTABLE must remove the vtable.");
+#endif
+
+    cave::CompactVector<int> vec;
+    assert(vec.empty());
+    assert(vec.capacity() == 0);
+
+    // Test pushBack and small allocations
+    vec.pushBack(1);
+    assert(vec.size() == 1);
+    assert(vec.capacity() == vec.minAllocatedSlots);
+    for (int i=2; i<=100; i++){
+        vec.pushBack(i);
+    }
+    assert(vec.size() == 100);
+    assert(vec.front() == 1);
+    assert(vec.back() == 100);
+    assert(vec.at(49) == 50);
+    try {
+        vec.at(100);
+        assert(false);
+    } catch (cave::OutOfRangeException&) {
+        assert(true);
+    }
+
+    // Test iteration
+    {
+        int sum = 0;
+        for (int e : vec){
+            sum += e;
+        }
+        assert(sum == 5050);
+    }
+
+    // Test find, erase, eraseUnordered and sort
+    assert(vec.findID(10) == 9);
+    assert(vec.contains(100));
+    assert(!vec.contains(101));
+
+    vec.erase(0, 50);
+    assert(vec.size() == 50);
+    assert(vec.front() == 51);
+
+    vec.eraseUnordered(0);
+    assert(vec.size() == 49);
+    assert(vec.front() == 100);
+    vec.eraseUnordered(49); // Out of range: nothing happens.
+    assert(vec.size() == 49);
+
+    vec.sort();
+    assert(vec.front() == 52);
+    assert(vec.back() == 100);
+
+    // Test resize, shrinkToFit and clear
+    vec.resize(10);
+    assert(vec.size() == 10);
+    vec.shrinkToFit();
+    assert(vec.capacity() == 16);
+    vec.resize(12);
+    assert(vec[11] == 0);
+    vec.clear();
+    assert(vec.empty());
+
+    // Test with non trivial objects, copy and move
+    {
+        cave::CompactVector<cave::String> strs = {"a", "b", "c", "d", "e"};
+        cave::CompactVector<cave::String> copy = strs;
+        assert(copy == strs);
+        assert(copy[4] == "e");
+
+        copy.erase(1);
+        assert(copy.size() == 4);
+        assert(copy[1] == "c");
+        assert(copy != strs);
+
+        cave::CompactVector<cave::String> moved = std::move(strs);
+        assert(strs.empty());
+        assert(moved.size() == 5);
+        moved.emplaceBack("f");
+        assert(moved.back() == "f");
+
+        copy = moved;
+        assert(copy == moved);
+    }
+
+    std::cout << "[COMPACT VECTOR] All tests passed!" << std::endl;
+}
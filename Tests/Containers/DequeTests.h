@@ -0,0 +1,242 @@
+#pragma once
+
+#include <cassert>
+#include <cstring>
+#include <iostream>
+#include <algorithm> // std::sort
+
+#include "Containers/Deque.h"
+#include "Containers/String.h"
+#include "Containers/Exception.h"
+
+
+void testCaveDeque() {
+    std::cout << "[DEQUE] Running tests...\n";
+
+    cave::Deque<int> dq;
+    assert(dq.empty());
+    assert(dq.capacity() == 0);
+    assert(dq.firstSpan().empty() && dq.secondSpan().empty());
+
+    // Test pushing on both ends
+    for (int i=0; i<10; i++){
+        dq.pushBack(i);
+        dq.pushFront(-i - 1);
+    }
+    assert(dq.size() == 20);
+    assert(dq.front() == -10);
+    assert(dq.back() == 9);
+    for (int i=0; i<20; i++){
+        assert(dq[i] == i - 10);
+    }
+    try {
+        dq.at(20);
+        assert(false);
+    } catch (cave::OutOfRangeException&) {
+        assert(true);
+    }
+
+    // Test popping on both ends
+    dq.popFront();
+    dq.popBack();
+    assert(dq.size() == 18);
+    assert(dq.front() == -9);
+    assert(dq.back() == 8);
+
+    // Test the ring wrapping around (FIFO usage never grows the buffer)
+    {
+        cave::Deque<int> queue;
+        for (int i=0; i<10; i++){
+            queue.pushBack(i);
+        }
+        const size_t capacity = queue.capacity();
+        int next = 0;
+        for (int i=10; i<1000; i++){
+            assert(queue.front() == next++);
+            queue.popFront();
+            queue.pushBack(i);
+        }
+        assert(queue.capacity() == capacity);
+        assert(queue.size() == 10);
+
+        // The contents are split in two spans when wrapped:
+        cave::Span<int> first = queue.firstSpan();
+        cave::Span<int> second = queue.secondSpan();
+        assert(first.size() + second.size() == queue.size());
+        int copy[10];
+        memcpy(copy, first.data(), first.size() * sizeof(int));
+        memcpy(copy + first.size(), second.data(), second.size() * sizeof(int));
+        for (int i=0; i<10; i++){
+            assert(copy[i] == queue[i]);
+            assert(copy[i] == 990 + i);
+        }
+
+        // Growing while wrapped keeps the order:
+        for (int i=1000; i<1100; i++){
+            queue.pushBack(i);
+        }
+        for (size_t i=0; i<queue.size(); i++){
+            assert(queue[i] == int(990 + i));
+        }
+        assert(queue.secondSpan().empty());
+    }
+
+    // Test the iterators
+    {
+        cave::Deque<int> d = {5, 3, 1};
+        d.pushFront(4);
+        d.pushFront(2);
+        std::sort(d.begin(), d.end());
+        for (int i=0; i<5; i++){
+            assert(d[i] == i + 1);
+        }
+        const cave::Deque<int>& cd = d;
+        int sum = 0;
+        for (int e : cd){
+            sum += e;
+        }
+        assert(sum == 15);
+        assert(cd.end() - cd.begin() == 5);
+        // Mixing Iterator and ConstIterator:
+        assert(d.begin() == cd.begin());
+        assert(cd.end() == d.end());
+        assert(d.begin() != cd.end());
+        assert(d.begin() < cd.end() && cd.begin() <= d.begin());
+        assert(d.end() - cd.begin() == 5);
+    }
+
+    // Test non trivial types, copying and moving
+    {
+        cave::Deque<cave::String> strs;
+        strs.pushBack("engine");
+        strs.emplaceFront("cave");
+        strs.pushBack("rocks");
+
+        cave::Deque<cave::String> copy = strs;
+        assert(copy == strs);
+        assert(copy[1] == "engine");
+
+        cave::Deque<cave::String> moved = std::move(copy);
+        assert(copy.empty());
+        assert(moved.front() == "cave");
+        moved.popFront();
+        assert(moved.front() == "engine");
+        assert(moved != strs);
+
+        strs = moved;
+        assert(strs == moved);
+        strs.clear();
+        assert(strs.empty());
+    }
+
+    std::cout << "[DEQUE] All tests passed!" << std::endl;
+}
+
+// Performance checks...
+
+#include <cstdio>
+#include <chrono>
+#include <deque>
+
+#include "Containers/List.h"
+
+void testDequePerformance() {
+    const int N = 1000000;
+
+    std::cout << " - (We'll be testing it with " << N << " elements.)\n";
+
+    printf("          |  std::deque | cave::List | cave::Deque |\n");
+    size_t dur1 = 0;
+    size_t dur2 = 0;
+    size_t dur3 = 0;
+
+    std::deque<int> d1;
+    cave::List<int> d2;
+    cave::Deque<int> d3;
+
+    // Test adding performance (on both ends)
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < N; i++) {
+        if (i & 1) { d1.push_back(i); } else { d1.push_front(i); }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    dur1 = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+    start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < N; i++) {
+        if (i & 1) { d2.pushBack(i); } else { d2.pushFront(i); }
+    }
+    end = std::chrono::high_resolution_clock::now();
+    dur2 = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+    start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < N; i++) {
+        if (i & 1) { d3.pushBack(i); } else { d3.pushFront(i); }
+    }
+    end = std::chrono::high_resolution_clock::now();
+    dur3 = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    printf("   Adding | %8zu us | %7zu us | %8zu us |", dur1, dur2, dur3);
+    if (dur1 < dur3){ printf(" BAD!"); }
+    printf("\n");
+
+    // Test iteration performance
+    long long count1 = 0;
+    long long count2 = 0;
+    long long count3 = 0;
+    start = std::chrono::high_resolution_clock::now();
+    for (auto& i : d1) {
+        count1 += i;
+    }
+    end = std::chrono::high_resolution_clock::now();
+    dur1 = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+    start = std::chrono::high_resolution_clock::now();
+    for (auto& i : d2) {
+        count2 += i;
+    }
+    end = std::chrono::high_resolution_clock::now();
+    dur2 = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+    start = std::chrono::high_resolution_clock::now();
+    for (int i : d3.firstSpan()) {
+        count3 += i;
+    }
+    for (int i : d3.secondSpan()) {
+        count3 += i;
+    }
+    end = std::chrono::high_resolution_clock::now();
+    dur3 = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    printf("Iterating | %8zu us | %7zu us | %8zu us |", dur1, dur2, dur3);
+    if (dur1 < dur3){ printf(" BAD!"); }
+    printf("\n");
+
+    assert(count1 == count2 && count1 == count3); // Little assert just to make sure...
+
+    // Test a queue (FIFO) workload
+    start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < N; i++) {
+        d1.pop_front();
+        d1.push_back(i);
+    }
+    end = std::chrono::high_resolution_clock::now();
+    dur1 = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+    start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < N; i++) {
+        d2.popFront();
+        d2.pushBack(i);
+    }
+    end = std::chrono::high_resolution_clock::now();
+    dur2 = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+    start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < N; i++) {
+        d3.popFront();
+        d3.pushBack(i);
+    }
+    end = std::chrono::high_resolution_clock::now();
+    dur3 = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    printf("    Queue | %8zu us | %7zu us | %8zu us |", dur1, dur2, dur3);
+    if (dur1 < dur3){ printf(" BAD!"); }
+    printf("\n");
+}
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+
+#include "Containers/EytzingerArray.h"
+#include "Containers/Vector.h"
+
+
+void testCaveEytzingerArray() {
+    std::cout << "[EYTZINGER ARRAY] Running tests...\n";
+
+    cave::EytzingerArray<int> empty;
+    assert(empty.empty());
+    assert(empty.size() == 0);
+    assert(empty.lowerBound(10) == 0);
+    assert(empty.upperBound(10) == 0);
+    assert(!empty.contains(10));
+
+    // Every size from 1 to 100 (full and incomplete trees), with duplicates:
+    for (int n = 1; n <= 100; n++){
+        cave::Vector<int> sorted;
+        for (int i = 0; i < n; i++){
+            sorted.pushBack((i / 3) * 2); // 0 0 0 2 2 2 4...
+        }
+        cave::EytzingerArray<int> arr(sorted);
+        assert(arr.size() == size_t(n));
+
+        for (int value = -1; value <= n + 1; value++){
+            assert(arr.lowerBound(value) == sorted.lowerBound(value));
+            assert(arr.upperBound(value) == sorted.upperBound(value));
+            assert(arr.contains(value) == sorted.contains(value));
+        }
+    }
+
+    // The positions are computed from the slots: check every one on bigger trees.
+    for (size_t n = 100; n <= 5000; n += 37){
+        cave::Vector<int> sorted;
+        for (size_t i = 0; i < n; i++){
+            sorted.pushBack(int(i * 2));
+        }
+        cave::EytzingerArray<int> arr(sorted);
+        for (size_t i = 0; i < n; i++){
+            assert(arr.lowerBound(int(i * 2)) == i);
+            assert(arr.upperBound(int(i * 2)) == i + 1);
+        }
+        assert(arr.lowerBound(int(n * 2)) == n);
+    }
+
+    // BFS order: the root is the middle element.
+    {
+        cave::Vector<int> sorted = {1, 2, 3, 4, 5, 6, 7};
+        cave::EytzingerArray<int> arr(sorted);
+        assert(arr.keys()[1] == 4);
+        assert(arr.keys()[2] == 2 && arr.keys()[3] == 6);
+        assert(arr.keys()[4] == 1 && arr.keys()[7] == 7);
+
+        arr.clear();
+        assert(arr.empty());
+        arr.build(sorted.data(), 3);
+        assert(arr.size() == 3);
+        assert(arr.lowerBound(3) == 2);
+        assert(arr.lowerBound(4) == 3);
+    }
+
+    // Floats (keyframe times):
+    {
+        cave::Vector<float> times = {0.0f, 0.25f, 0.5f, 1.0f, 2.0f};
+        cave::EytzingerArray<float> arr(times);
+        assert(arr.lowerBound(0.3f) == 2);
+        assert(arr.lowerBound(0.5f) == 2);
+        assert(arr.upperBound(0.5f) == 3);
+        assert(arr.lowerBound(3.0f) == 5);
+    }
+
+    std::cout << "[EYTZINGER ARRAY] All tests passed!" << std::endl;
+}
+
+// Performance checks...
+
+#include <cstdio>
+#include <chrono>
+
+void testEytzingerArrayPerformance() {
+    const size_t queries = 1000000;
+
+    // Sizes only go up to 10M keys, so the test doesn't take too much memory.
+    std::cout << " - (" << queries << " lower bound queries for each size.)\n";
+    printf("          | Vector::lowerBound | EytzingerArray |\n");
+
+    for (size_t n = 1000; n <= 10000000; n *= 10) {
+        cave::Vector<uint32_t> sorted;
+        sorted.resizeUninitialized(n);
+        for (size_t i = 0; i < n; i++) {
+            sorted[i] = uint32_t(i * 3);
+        }
+        cave::EytzingerArray<uint32_t> arr(sorted);
+
+        cave::Vector<uint32_t> keys;
+        keys.resizeUninitialized(queries);
+        uint64_t seed = 42;
+        for (size_t i = 0; i < queries; i++) {
+            seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+            keys[i] = uint32_t((seed >> 33) % (n * 3));
+        }
+
+        size_t sum1 = 0;
+        size_t sum2 = 0;
+
+        auto start = std::chrono::high_resolution_clock::now();
+        for (size_t i = 0; i < queries; i++) {
+            sum1 += sorted.lowerBound(keys[i]);
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        size_t dur1 = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+        start = std::chrono::high_resolution_clock::now();
+        for (size_t i = 0; i < queries; i++) {
+            sum2 += arr.lowerBound(keys[i]);
+        }
+        end = std::chrono::high_resolution_clock::now();
+        size_t dur2 = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+        printf(" %8zu | %15zu us | %11zu us |", n, dur1, dur2);
+        if (dur1 < dur2){ printf(" BAD!"); }
+        printf("\n");
+
+        assert(sum1 == sum2); // Little assert just to make sure...
+    }
+}
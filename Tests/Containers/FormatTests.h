@@ -0,0 +1,277 @@
+#pragma once
+
+#include <cassert>
+#include <cstring>
+#include <iostream>
+#include <limits>
+
+#include "Containers/Format.h"
+#include "Containers/StringBuilder.h"
+#include "Containers/String.h"
+#include "Containers/Vector.h"
+#include "Containers/Pair.h"
+#include "Containers/Name.h"
+
+
+// A user type, to test custom formatters:
+struct FormatTestVec2 {
+    float x, y;
+};
+
+template <>
+struct cave::Formatter<FormatTestVec2> {
+    static void format(cave::FormatOutput& out, const FormatTestVec2& v, const cave::FormatSpec& spec) {
+        out.write("<", 1);
+        cave::Formatter<float>::format(out, v.x, spec);
+        out.write(", ", 2);
+        cave::Formatter<float>::format(out, v.y, spec);
+        out.write(">", 1);
+    }
+};
+
+void testCaveFormat() {
+    std::cout << "[FORMAT] Running tests...\n";
+
+    // Test basic formatting
+    assert(cave::format("") == "");
+    assert(cave::format("no fields") == "no fields");
+    assert(cave::format("{}", 42) == "42");
+    assert(cave::format("{} at {:.3f}", cave::String("hero"), 3.14159) == "hero at 3.142");
+    assert(cave::format("{}{}{}", 'a', "b", cave::StringView("c")) == "abc");
+    assert(cave::format("{} {}", true, false) == "true false");
+    assert(cave::format("{{}} {{{}}}", 7) == "{} {7}");
+    assert(cave::format("{}", std::string("std")) == "std");
+
+    // Test integers
+    assert(cave::format("{}", -42) == "-42");
+    assert(cave::format("{}", std::numeric_limits<long long>::min()) == "-9223372036854775808");
+    assert(cave::format("{}", std::numeric_limits<unsigned long long>::max()) == "18446744073709551615");
+    assert(cave::format("{:x} {:X} {:b} {:o}", 255, 255, 5, 8) == "ff FF 101 10");
+    assert(cave::format("{:x}", -255) == "-ff");
+    assert(cave::format("{:c}", 65) == "A");
+    assert(cave::format("{:d}", 'A') == "65");
+    assert(cave::format("{}", (unsigned char)200) == "200");
+
+    // Test floats
+    assert(cave::format("{}", 0.1f) == "0.1");
+    assert(cave::format("{}", 0.1) == "0.1");
+    assert(cave::format("{:.2f}", 2.0f / 3.0f) == "0.67");
+    assert(cave::format("{:f}", 1.5) == "1.500000");
+    assert(cave::format("{:.0f}", 2.5) == "2");
+    assert(cave::format("{:.2e}", 12345.0) == "1.23e+04");
+    assert(cave::format("{:g}", 0.0001) == "0.0001");
+
+    // Test width, fill and alignment
+    assert(cave::format("[{:5}]", 42) == "[   42]");
+    assert(cave::format("[{:5}]", "ab") == "[ab   ]");
+    assert(cave::format("[{:<5}]", 42) == "[42   ]");
+    assert(cave::format("[{:>5}]", "ab") == "[   ab]");
+    assert(cave::format("[{:^6}]", "ab") == "[  ab  ]");
+    assert(cave::format("[{:*^7}]", "ab") == "[**ab***]");
+    assert(cave::format("[{:05}]", -42) == "[-0042]");
+    assert(cave::format("[{:08.3f}]", -1.5) == "[-001.500]");
+    assert(cave::format("[{:08x}]", 0xBEEF) == "[0000beef]");
+    assert(cave::format("[{:2}]", 12345) == "[12345]");
+    assert(cave::format("[{:.3}]", "abcdef") == "[abc]");
+    assert(cave::format("[{:>6.2}]", "abcdef") == "[    ab]");
+    {
+        // Wider than the fill chunks:
+        const cave::String wide = cave::format("{:>100}", "x");
+        assert(wide.size() == 100 && wide[99] == 'x' && wide[0] == ' ');
+    }
+
+    // Test containers and names
+    {
+        cave::Vector<int> v = {1, 2, 3};
+        assert(cave::format("{}", v) == "[1, 2, 3]");
+        assert(cave::format("{:02}", v) == "[01, 02, 03]");
+        assert(cave::format("{}", cave::Vector<int>()) == "[]");
+        assert(cave::format("{}", cave::Span<const int>(v.data(), 2)) == "[1, 2]");
+
+        cave::Vector<cave::String> names = {"a", "b"};
+        assert(cave::format("{}", names) == "[a, b]");
+
+        assert(cave::format("{}", cave::Pair<int, cave::String>(1, "one")) == "(1, one)");
+        assert(cave::format("{}", cave::Name("Player")) == "Player");
+        assert(cave::format("{}", FormatTestVec2{1.0f, 0.5f}) == "<1, 0.5>");
+        assert(cave::format("{:.1f}", FormatTestVec2{1.0f, 0.5f}) == "<1.0, 0.5>");
+    }
+
+    // Test formatting into Strings, StringBuilders and buffers
+    {
+        cave::String log = "[INFO] ";
+        cave::formatTo(log, "{} loaded in {}ms", "level1", 16);
+        assert(log == "[INFO] level1 loaded in 16ms");
+
+        cave::StringBuilder sb;
+        sb << "a=";
+        cave::formatTo(sb, "{:>3}|", 1);
+        cave::formatTo(sb, "{:<3}|", 2);
+        assert(sb.view() == "a=  1|2  |");
+
+        char buffer[16];
+        assert(cave::formatTo(buffer, sizeof(buffer), "{}+{}", 1, 2) == 3);
+        assert(strcmp(buffer, "1+2") == 0);
+        // Truncated (but still null terminated), returning the full size:
+        assert(cave::formatTo(buffer, 8, "{}", "0123456789") == 10);
+        assert(strcmp(buffer, "0123456") == 0);
+        assert(cave::formatTo(buffer, 0, "{}", 12) == 2);
+
+        // Bigger than the internal stack buffer:
+        const cave::String big = cave::String(std::string(1000, 'x').c_str());
+        assert(cave::format("<{}>", big).size() == 1002);
+    }
+
+    // Test compile time checked format strings (in C++17 too)
+    {
+        assert(cave::format(CAVE_FORMAT("{} at {:.3f}"), cave::String("hero"), 3.14159) == "hero at 3.142");
+        assert(cave::format(CAVE_FORMAT("no fields")) == "no fields");
+        cave::String out = "> ";
+        cave::formatTo(out, CAVE_FORMAT("{:>4}|{:<3}|"), 12, 'x');
+        assert(out == ">   12|x  |");
+        char buffer[16];
+        assert(cave::formatTo(buffer, sizeof(buffer), CAVE_FORMAT("{{{}}}"), 7) == 3);
+        assert(strcmp(buffer, "{7}") == 0);
+        static_assert(cave::formatting::checkFormat<int, double>("{} {:08.2f}", 11), "");
+        static_assert(cave::formatting::checkFormat<char, cave::String, bool>("{:x} {:.2} {:>5}", 16), "");
+        static_assert(!cave::formatting::checkFormat<int>("{} {}", 5), "");
+        // These don't compile (and neither do the literals alone in C++20):
+        // cave::format(CAVE_FORMAT("{} {}"), 1);
+        // cave::format(CAVE_FORMAT("{:q}"), 1);
+        // cave::format(CAVE_FORMAT("{:.3f}"), cave::String("hero")); // Float spec, text argument.
+        // cave::format(CAVE_FORMAT("{:d}"), 1.5);                    // Integer spec, float argument.
+        // cave::format(CAVE_FORMAT("{:.2}"), 12);                    // Integers don't take a precision.
+    }
+
+    // Test runtime format strings (checked while formatting)
+    {
+        const cave::String fmt = "{}-{}";
+        assert(cave::format(cave::runtimeFormat(fmt), 1, 2) == "1-2");
+
+        const char* bad[] = {"{", "}", "{0}", "{:.}", "{:z}", "{}{}{}", "{}", ""};
+        for (const char* str : bad){
+            bool thrown = false;
+            try {
+                cave::format(cave::runtimeFormat(str), 1, 2);
+            }
+            catch (const cave::FormatException&){
+                thrown = true;
+            }
+            assert(thrown);
+        }
+        // More arguments than fields (they were silently dropped):
+        bool thrown = false;
+        try {
+            cave::format(cave::runtimeFormat("{}"), 1, 2, 3);
+        }
+        catch (const cave::FormatException&){
+            thrown = true;
+        }
+        assert(thrown);
+
+        // The wrong type for the argument:
+        thrown = false;
+        try {
+            cave::format(cave::runtimeFormat("{:x}"), "text");
+        }
+        catch (const cave::FormatException&){
+            thrown = true;
+        }
+        assert(thrown);
+#if !defined(CAVE_FORMAT_COMPILE_CHECKS)
+        // (Only compiles in C++17, where plain literals are checked while formatting.)
+        thrown = false;
+        try {
+            cave::format("{:.3f}", cave::String("hero"));
+        }
+        catch (const cave::FormatException&){
+            thrown = true;
+        }
+        assert(thrown);
+#endif
+        thrown = false;
+        try {
+            cave::format(cave::runtimeFormat("{:d}"), 1.5);
+        }
+        catch (const cave::FormatException&){
+            thrown = true;
+        }
+        assert(thrown);
+        thrown = false;
+        try {
+            cave::format(cave::runtimeFormat("{:.2}"), 12);
+        }
+        catch (const cave::FormatException&){
+            thrown = true;
+        }
+        assert(thrown);
+    }
+
+    std::cout << "[FORMAT] All tests passed!" << std::endl;
+}
+
+// Performance checks...
+
+#include <cstdio>
+#include <chrono>
+#include <string>
+
+void testFormatPerformance() {
+    const int N = 200000;
+
+    std::cout << " - (We'll be testing it with " << N << " log lines.)\n";
+
+    printf("          | std::to_string + operator+ | cave::format |\n");
+    size_t dur1 = 0;
+    size_t dur2 = 0;
+
+    const std::string name1 = "PlayerController";
+    const cave::String name2 = "PlayerController";
+
+    // Test building log lines (the old way vs format)
+    size_t total1 = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < N; i++) {
+        std::string line = "[" + name1 + "] frame " + std::to_string(i) + " took " + std::to_string(float(i) * 0.001f) + "ms";
+        total1 += line.size();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    dur1 = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+    size_t total2 = 0;
+    start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < N; i++) {
+        cave::String line = cave::format("[{}] frame {} took {:f}ms", name2, i, float(i) * 0.001f);
+        total2 += line.size();
+    }
+    end = std::chrono::high_resolution_clock::now();
+    dur2 = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    printf("   Format | %23zu us | %9zu us |", dur1, dur2);
+    if (dur1 < dur2){ printf(" BAD!"); }
+    printf("\n");
+
+    assert(total1 == total2); // Little assert just to make sure...
+
+    // Test formatting into a stack buffer (vs snprintf)
+    char buffer[128];
+    total1 = 0;
+    start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < N; i++) {
+        total1 += size_t(snprintf(buffer, sizeof(buffer), "[%s] frame %d took %fms", name1.c_str(), i, double(float(i) * 0.001f)));
+    }
+    end = std::chrono::high_resolution_clock::now();
+    dur1 = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+    total2 = 0;
+    start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < N; i++) {
+        total2 += cave::formatTo(buffer, sizeof(buffer), "[{}] frame {} took {:f}ms", name2, i, float(i) * 0.001f);
+    }
+    end = std::chrono::high_resolution_clock::now();
+    dur2 = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    printf("   Buffer | %23zu us | %9zu us |", dur1, dur2);
+    if (dur1 < dur2){ printf(" BAD!"); }
+    printf("\n");
+
+    assert(total1 == total2);
+}
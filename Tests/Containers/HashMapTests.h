@@ -3,6 +3,8 @@
 #include <cassert>
 #include <cstring>
 #include <iostream>
+#include <iterator> // std::iterator_traits
+#include <type_traits>
 
 #include "Containers/String.h"
 #include "Containers/StringHash.h"
@@ -77,6 +79,38 @@ void testCaveHashMap() {
     // Test find
     assert(map.find("it second") != map.end());
     assert(map.find("invalid key") == map.end());
+
+    // Test the const iterators
+    {
+        using CIt = cave::HashMap<cave::String, int>::ConstIterator;
+        static_assert(std::is_same<std::iterator_traits<CIt>::iterator_category, std::bidirectional_iterator_tag>::value, "");
+
+        const cave::HashMap<cave::String, int>& cMap = map;
+        CIt it = cMap.find("it second");
+        assert(it != cMap.end() && it->second == 2);
+        assert(it == map.find("it second"));
+        assert(std::distance(cMap.begin(), cMap.end()) == 3);
+        assert(cMap.at("it third") == 3);
+    }
+
+    // Test looking up with views (no String is built)
+    {
+        cave::StringView key = cave::StringView("it second, and more").substr(0, 9);
+        assert(map.find(key) != map.end());
+        assert(map.find(key)->second == 2);
+        assert(map.at(key) == 2);
+        assert(map.count(key) == 1);
+        assert(!map.exists(cave::StringView("it fourth")));
+
+        const cave::HashMap<cave::String, int>& cMap = map;
+        assert(cMap.find(key) == cMap.find("it second"));
+        try {
+            cMap.at(cave::StringView("nope"));
+            assert(false);
+        } catch (cave::OutOfRangeException&) {
+            assert(true);
+        }
+    }
     
     std::cout << "[HASH MAP] All tests passed!" << std::endl;
 }
@@ -3,6 +3,9 @@
 #include <cassert>
 #include <cstring>
 #include <iostream>
+#include <iterator> // std::iterator_traits
+#include <algorithm> // std::find
+#include <type_traits>
 
 #include "Containers/List.h"
 #include "Containers/Exception.h"
@@ -149,6 +152,18 @@ void testCaveListIterator() {
     assert(it == list.begin());
     assert(it != list.end());
 
+    //Testing the traits and the const iterator
+    using CIt = cave::List<int>::ConstIterator;
+    static_assert(std::is_same<std::iterator_traits<cave::List<int>::Iterator>::iterator_category, std::bidirectional_iterator_tag>::value, "");
+    static_assert(std::is_same<std::iterator_traits<CIt>::reference, const int&>::value, "");
+
+    const cave::List<int>& cList = list;
+    CIt cit = std::find(cList.begin(), cList.end(), 2);
+    assert(cit != cList.end() && *cit == 2);
+    assert(cit == ++list.begin());
+    assert(std::distance(cList.begin(), cList.end()) == 3);
+    assert(cList[2] == 3);
+
     std::cout << "[LIST | ITERATOR] All tests passed!" << std::endl;
 }
 
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cassert>
+#include <cstdio>
+#include <cstdint>
+#include <iostream>
+
+#include "Containers/MappedVector.h"
+#include "Containers/Vector.h"
+#include "Containers/Exception.h"
+
+
+void testCaveMappedVector() {
+    std::cout << "[MAPPED VECTOR] Running tests...\n";
+
+    const char* path = "cave_mapped_vector_test.bin";
+
+    // Writing the test file:
+    {
+        cave::Vector<uint32_t> values;
+        for (uint32_t i=0; i<10000; i++){
+            values.pushBack(i * 3);
+        }
+        FILE* f = fopen(path, "wb");
+        assert(f);
+        fwrite(values.data(), sizeof(uint32_t), values.size(), f);
+        fclose(f);
+    }
+
+    // Test a file that doesn't exist
+    {
+        cave::MappedVector<uint32_t> vec;
+        assert(!vec.open("this_file_does_not_exist.bin"));
+        assert(!vec.isOpen());
+        assert(vec.empty());
+    }
+
+    // Test mapping it
+    {
+        cave::MappedVector<uint32_t> vec;
+        assert(vec.open(path, cave::MappedVector<uint32_t>::Access::Sequential));
+        assert(vec.isOpen());
+        assert(vec.size() == 10000);
+        assert(vec.front() == 0);
+        assert(vec.back() == 9999 * 3);
+        assert(vec[10] == 30);
+        assert(vec.at(20) == 60);
+        try {
+            vec.at(10000);
+            assert(false);
+        } catch (cave::OutOfRangeException&) {
+            assert(true);
+        }
+
+        uint64_t sum = 0;
+        for (uint32_t e : vec){
+            sum += e;
+        }
+        assert(sum == 3ull * 9999 * 10000 / 2);
+
+        vec.advise(cave::MappedVector<uint32_t>::Access::Random);
+        assert(vec.findID(300) == 100);
+        assert(vec.findID(301) == cave::MappedVector<uint32_t>::npos);
+        assert(*vec.find(600) == 600);
+        assert(vec.find(1) == vec.end());
+        assert(vec.contains(29997));
+
+        cave::Vector<uint32_t> copy = vec.toVector();
+        assert(copy.size() == vec.size());
+        assert(copy[9999] == 29997);
+
+        // Test move
+        cave::MappedVector<uint32_t> moved = std::move(vec);
+        assert(!vec.isOpen());
+        assert(moved.size() == 10000);
+
+        moved.close();
+        assert(moved.empty());
+    }
+
+    // A file size that isn't a multiple of sizeof(T) is rejected
+    {
+        cave::MappedVector<uint64_t> vec;
+        FILE* f = fopen(path, "ab");
+        fputc(1, f);
+        fclose(f);
+        assert(!vec.open(path));
+    }
+
+    remove(path);
+
+    std::cout << "[MAPPED VECTOR] All tests passed!" << std::endl;
+}
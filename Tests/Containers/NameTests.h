@@ -0,0 +1,176 @@
+#pragma once
+
+#include <cassert>
+#include <cstring>
+#include <iostream>
+#include <string> // std::to_string
+#include <thread>
+
+#include "Containers/Name.h"
+#include "Containers/String.h"
+#include "Containers/StringHash.h"
+#include "Containers/HashMap.h"
+
+
+void testCaveName() {
+    std::cout << "[NAME] Running tests...\n";
+
+    cave::Name none;
+    assert(none.empty());
+    assert(none.id() == 0);
+    assert(none.size() == 0);
+    assert(strcmp(none.c_str(), "") == 0);
+    assert(cave::Name("") == none);
+
+    // Test interning
+    const size_t tableSize = cave::Name::tableSize();
+    cave::Name a("RigidBody");
+    cave::Name b(cave::String("RigidBody"));
+    cave::Name c(cave::StringView("RigidBody Component").substr(0, 9));
+    assert(a == b && b == c);
+    assert(a.c_str() == c.c_str()); // Same storage!
+    assert(a.id() != 0 && a.id() == c.id());
+    assert(cave::Name::tableSize() == tableSize + 1);
+    assert(strcmp(a.c_str(), "RigidBody") == 0);
+    assert(a.size() == 9);
+
+    cave::Name d("Transform");
+    assert(a != d);
+    assert(a.id() != d.id());
+    assert((a < d) != (d < a));
+
+    // Test the string conversions and comparisons
+    assert(a == cave::StringView("RigidBody"));
+    assert(a != cave::StringView("RigidBod"));
+    cave::String str = a.toString();
+    assert(str == "RigidBody");
+    cave::StringView view = d;
+    assert(view == "Transform");
+    assert(std::hash<cave::Name>{}(a) == a.id());
+    assert(a.stringHash() == std::hash<cave::String>{}(str));
+
+    // Test looking up without interning
+    assert(cave::Name::find("Transform") == d);
+    assert(cave::Name::find("NotInterned").empty());
+    assert(cave::Name::tableSize() == tableSize + 2);
+
+    // Test a lot of names (growing the table)
+    {
+        cave::Vector<cave::Name> names;
+        for (int i=0; i<5000; i++){
+            names.pushBack(cave::Name(cave::String(std::to_string(i).c_str())));
+        }
+        for (int i=0; i<5000; i++){
+            const cave::String s = cave::String(std::to_string(i).c_str());
+            assert(names[i] == cave::Name(s));
+            assert(names[i] == s.view());
+        }
+        assert(a == cave::Name("RigidBody"));
+    }
+
+    // Test interning from many threads (all of them must agree)
+    {
+        const int threadCount = 4;
+        cave::Name results[threadCount][100];
+        std::thread threads[threadCount];
+        for (int t=0; t<threadCount; t++){
+            threads[t] = std::thread([&results, t](){
+                for (int i=0; i<100; i++){
+                    results[t][i] = cave::Name(cave::String("bone_") + cave::String(std::to_string(i).c_str()));
+                }
+            });
+        }
+        for (int t=0; t<threadCount; t++){
+            threads[t].join();
+        }
+        for (int t=1; t<threadCount; t++){
+            for (int i=0; i<100; i++){
+                assert(results[t][i] == results[0][i]);
+            }
+        }
+    }
+
+    // Test using it as a key
+    {
+        cave::HashMap<cave::Name, int> map;
+        map[a] = 1;
+        map[d] = 2;
+        assert(map[cave::Name("RigidBody")] == 1);
+        assert(map.at(d) == 2);
+        assert(!map.exists(cave::Name("Collider")));
+    }
+
+    std::cout << "[NAME] All tests passed!" << std::endl;
+}
+
+// Performance checks...
+
+#include <cstdio>
+#include <chrono>
+
+void testNamePerformance() {
+    const int N = 200000;
+    const int K = 64;
+
+    std::cout << " - (We'll be comparing " << N << " times against " << K << " identifiers.)\n";
+
+    cave::String strs[K];
+    cave::Name names[K];
+    for (int i=0; i<K; i++){
+        strs[i] = cave::String("material.parameter_") + cave::String(std::to_string(i).c_str());
+        names[i] = cave::Name(strs[i]);
+    }
+    const cave::String strKey = strs[K - 1];
+    const cave::Name nameKey(strKey);
+
+    printf("          | cave::String | cave::Name |\n");
+    size_t dur1 = 0;
+    size_t dur2 = 0;
+
+    // Test comparing performance (a linear lookup)
+    size_t found1 = 0;
+    size_t found2 = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int n = 0; n < N; n++) {
+        for (int i = 0; i < K; i++) {
+            found1 += strs[i] == strKey;
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    dur1 = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+    start = std::chrono::high_resolution_clock::now();
+    for (int n = 0; n < N; n++) {
+        for (int i = 0; i < K; i++) {
+            found2 += names[i] == nameKey;
+        }
+    }
+    end = std::chrono::high_resolution_clock::now();
+    dur2 = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    printf("Comparing | %9zu us | %7zu us |", dur1, dur2);
+    if (dur1 < dur2){ printf(" BAD!"); }
+    printf("\n");
+
+    assert(found1 == found2);
+
+    // Test hashing performance
+    size_t hash1 = 0;
+    size_t hash2 = 0;
+    start = std::chrono::high_resolution_clock::now();
+    for (int n = 0; n < N; n++) {
+        hash1 += std::hash<cave::String>{}(strs[n % K]);
+    }
+    end = std::chrono::high_resolution_clock::now();
+    dur1 = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+    start = std::chrono::high_resolution_clock::now();
+    for (int n = 0; n < N; n++) {
+        hash2 += std::hash<cave::Name>{}(names[n % K]);
+    }
+    end = std::chrono::high_resolution_clock::now();
+    dur2 = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    printf("  Hashing | %9zu us | %7zu us |", dur1, dur2);
+    if (dur1 < dur2){ printf(" BAD!"); }
+    printf("\n");
+    assert(hash1 != 0 && hash2 != 0); // (So the loops aren't optimized away.)
+}
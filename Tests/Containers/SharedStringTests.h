@@ -0,0 +1,225 @@
+#pragma once
+
+#include <cassert>
+#include <cstring>
+#include <iostream>
+#include <string> // std::to_string
+#include <thread>
+#include <utility> // std::move
+
+#include "Containers/SharedString.h"
+#include "Containers/String.h"
+#include "Containers/StringHash.h"
+#include "Containers/HashMap.h"
+#include "Containers/Vector.h"
+
+
+void testCaveSharedString() {
+    std::cout << "[SHARED STRING] Running tests...\n";
+
+    cave::SharedString none;
+    assert(none.empty());
+    assert(none.size() == 0);
+    assert(none.useCount() == 0);
+    assert(strcmp(none.c_str(), "") == 0);
+    assert(none == cave::SharedString(""));
+    assert(none.hash() == std::hash<cave::StringView>{}(cave::StringView()));
+
+    // Test creating and sharing
+    cave::SharedString a("textures/rock_albedo.png");
+    assert(a.size() == 24);
+    assert(strcmp(a.c_str(), "textures/rock_albedo.png") == 0);
+    assert(a[0] == 't' && a.at(23) == 'g');
+    assert(a.useCount() == 1);
+    {
+        cave::SharedString b = a;
+        assert(b.c_str() == a.c_str()); // Same chars!
+        assert(a.useCount() == 2);
+
+        cave::SharedString c;
+        c = b;
+        assert(a.useCount() == 3);
+        c = c;
+        assert(a.useCount() == 3);
+
+        cave::SharedString d = std::move(c);
+        assert(c.empty() && c.useCount() == 0);
+        assert(a.useCount() == 3);
+        assert(d == a);
+    }
+    assert(a.useCount() == 1);
+
+    bool thrown = false;
+    try {
+        a.at(24);
+    }
+    catch (const cave::OutOfRangeException&){
+        thrown = true;
+    }
+    assert(thrown);
+
+    // Test the conversions and comparisons
+    {
+        const cave::String str = "textures/rock_albedo.png";
+        cave::SharedString fromString(str);
+        assert(fromString == a);
+        assert(fromString.c_str() != a.c_str()); // Equal, but not shared.
+        assert(fromString == str);
+        assert(str == fromString.view());
+        assert(fromString.toString() == str);
+        assert(cave::String(fromString) == str);
+
+        cave::SharedString fromView(cave::StringView("rock, sand").substr(0, 4));
+        assert(fromView == "rock");
+        assert(fromView != "rocks");
+        assert(cave::StringView("rock") == fromView);
+        assert(fromView != a);
+        assert(fromView < cave::SharedString("sand"));
+        assert(!(cave::SharedString("sand") < fromView));
+    }
+
+    // Test the cached hash (the same as String's and StringView's)
+    {
+        const cave::String str = "textures/rock_albedo.png";
+        assert(a.hash() == std::hash<cave::String>{}(str));
+        assert(std::hash<cave::SharedString>{}(a) == std::hash<cave::StringView>{}(str.view()));
+        assert(cave::SharedString("x").hash() != cave::SharedString("y").hash());
+    }
+
+    // Test the non atomic version
+    {
+        cave::LocalSharedString local("event.player_died");
+        cave::LocalSharedString copy = local;
+        assert(local.useCount() == 2);
+        assert(copy == "event.player_died");
+        assert(copy.hash() == std::hash<cave::StringView>{}("event.player_died"));
+    }
+
+    // Test using it as a key (copying the map doesn't copy the chars)
+    {
+        cave::HashMap<cave::SharedString, int> map;
+        for (int i=0; i<100; i++){
+            map[cave::SharedString(cave::StringView(std::to_string(i).c_str()))] = i;
+        }
+        map[a] = 1000;
+        assert(a.useCount() == 2);
+
+        cave::HashMap<cave::SharedString, int> copy = map;
+        assert(copy.size() == map.size());
+        assert(a.useCount() == 3);
+        assert(copy[a] == 1000);
+        assert(copy.at(cave::SharedString("42")) == 42);
+        // Looking up with a view (without creating a SharedString):
+        assert(copy.find(cave::StringView("99"))->second == 99);
+        assert(copy.find(cave::StringView("100")) == copy.end());
+    }
+    assert(a.useCount() == 1);
+
+    // Test sharing between threads (the atomic count)
+    {
+        const int threadCount = 4;
+        cave::Vector<cave::SharedString> copies[threadCount];
+        std::thread threads[threadCount];
+        for (int t=0; t<threadCount; t++){
+            threads[t] = std::thread([&copies, &a, t](){
+                for (int i=0; i<1000; i++){
+                    copies[t].pushBack(a);
+                }
+                for (int i=0; i<500; i++){
+                    copies[t].popBack();
+                }
+            });
+        }
+        for (int t=0; t<threadCount; t++){
+            threads[t].join();
+        }
+        assert(a.useCount() == 1 + threadCount * 500);
+        for (int t=0; t<threadCount; t++){
+            copies[t].clear();
+        }
+        assert(a.useCount() == 1);
+    }
+
+    std::cout << "[SHARED STRING] All tests passed!" << std::endl;
+}
+
+// Performance checks...
+
+#include <cstdio>
+#include <chrono>
+
+void testSharedStringPerformance() {
+    const int N = 20000;
+    const int K = 20;
+
+    std::cout << " - (We'll be copying a map with " << N << " asset ids " << K << " times.)\n";
+
+    cave::HashMap<cave::String, int> map1;
+    cave::HashMap<cave::SharedString, int> map2;
+    for (int i=0; i<N; i++){
+        const cave::String id = cave::String("assets/models/environment/rocks/rock_") + cave::String(std::to_string(i).c_str()) + ".fbx";
+        map1[id] = i;
+        map2[cave::SharedString(id)] = i;
+    }
+
+    printf("          | cave::String | cave::SharedString |\n");
+    size_t dur1 = 0;
+    size_t dur2 = 0;
+
+    // Test copying (a copy of every key and a rehash)
+    size_t size1 = 0;
+    size_t size2 = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int k = 0; k < K; k++) {
+        cave::HashMap<cave::String, int> copy = map1;
+        size1 += copy.size();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    dur1 = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+    start = std::chrono::high_resolution_clock::now();
+    for (int k = 0; k < K; k++) {
+        cave::HashMap<cave::SharedString, int> copy = map2;
+        size2 += copy.size();
+    }
+    end = std::chrono::high_resolution_clock::now();
+    dur2 = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    printf("  Copying | %9zu us | %15zu us |", dur1, dur2);
+    if (dur1 < dur2){ printf(" BAD!"); }
+    printf("\n");
+
+    assert(size1 == size2);
+
+    // Test hashing performance
+    cave::Vector<cave::String> keys1;
+    cave::Vector<cave::SharedString> keys2;
+    for (auto& it : map1){
+        keys1.pushBack(it.first);
+    }
+    for (auto& it : map2){
+        keys2.pushBack(it.first);
+    }
+    size_t hash1 = 0;
+    size_t hash2 = 0;
+    start = std::chrono::high_resolution_clock::now();
+    for (int k = 0; k < K; k++) {
+        for (size_t i = 0; i < keys1.size(); i++) {
+            hash1 += std::hash<cave::String>{}(keys1[i]);
+        }
+    }
+    end = std::chrono::high_resolution_clock::now();
+    dur1 = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+    start = std::chrono::high_resolution_clock::now();
+    for (int k = 0; k < K; k++) {
+        for (size_t i = 0; i < keys2.size(); i++) {
+            hash2 += std::hash<cave::SharedString>{}(keys2[i]);
+        }
+    }
+    end = std::chrono::high_resolution_clock::now();
+    dur2 = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    printf("  Hashing | %9zu us | %15zu us |", dur1, dur2);
+    if (dur1 < dur2){ printf(" BAD!"); }
+    printf("\n");
+    assert(hash1 == hash2); // Same hashes, just cached.
+}
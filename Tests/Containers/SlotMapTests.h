@@ -0,0 +1,221 @@
+#pragma once
+
+#include <cassert>
+#include <iostream>
+#include <utility> // std::move
+
+#include "Containers/SlotMap.h"
+#include "Containers/String.h"
+#include "Containers/Exception.h"
+
+
+void testCaveSlotMap() {
+    std::cout << "[SLOT MAP] Running tests...\n";
+
+    cave::SlotMap<cave::String> map;
+    assert(map.empty());
+    assert(map.size() == 0);
+
+    // Test insert and get
+    auto h1 = map.insert("first");
+    auto h2 = map.insert(cave::String("second"));
+    auto h3 = map.emplace("third");
+    assert(map.size() == 3);
+    assert(map.contains(h1) && map.contains(h2) && map.contains(h3));
+    assert(*map.get(h1) == "first");
+    assert(map.at(h2) == "second");
+    assert(map[h3] == "third");
+
+    // An invalid (default) handle
+    cave::SlotMap<cave::String>::Handle invalid;
+    assert(!map.contains(invalid));
+    assert(map.get(invalid) == nullptr);
+
+    // Test erase: the other handles must still work
+    assert(map.erase(h1));
+    assert(map.size() == 2);
+    assert(!map.contains(h1));
+    assert(map.get(h1) == nullptr);
+    assert(map.at(h2) == "second");
+    assert(map.at(h3) == "third");
+    try {
+        map.at(h1);
+        assert(false); // Stale handle
+    } catch (cave::OutOfRangeException&) {
+        assert(true);
+    }
+    assert(!map.erase(h1));
+
+    // Test slot reuse: the new handle gets the same slot, but the old one stays stale
+    auto h4 = map.insert("fourth");
+    assert(h4.index == h1.index);
+    assert(h4 != h1);
+    assert(!map.contains(h1));
+    assert(map.at(h4) == "fourth");
+
+    // Test dense iteration and handleAt
+    {
+        size_t count = 0;
+        for (auto& value : map){
+            assert(!value.empty());
+            count++;
+        }
+        assert(count == map.size());
+
+        for (size_t i=0; i<map.size(); i++){
+            auto h = map.handleAt(i);
+            assert(&map[h] == map.data() + i);
+        }
+    }
+
+    // Test many inserts and erases
+    {
+        cave::SlotMap<int> ints;
+        cave::Vector<cave::SlotMap<int>::Handle> handles;
+        for (int i=0; i<1000; i++){
+            handles.pushBack(ints.insert(i));
+        }
+        for (int i=0; i<1000; i+=3){
+            assert(ints.erase(handles[i]));
+        }
+        for (int i=0; i<1000; i++){
+            if (i % 3 == 0){
+                assert(!ints.contains(handles[i]));
+            }
+            else {
+                assert(ints.at(handles[i]) == i);
+            }
+        }
+        assert(ints.size() == 666);
+
+        // Test clear: every handle becomes stale
+        ints.clear();
+        assert(ints.empty());
+        for (int i=0; i<1000; i++){
+            assert(!ints.contains(handles[i]));
+        }
+        auto h = ints.insert(1337);
+        assert(ints.at(h) == 1337);
+        assert(ints.size() == 1);
+    }
+
+    // Test copy
+    {
+        cave::SlotMap<cave::String> copy = map;
+        assert(copy.size() == map.size());
+        assert(copy.at(h4) == "fourth");
+        copy.erase(h4);
+        assert(map.at(h4) == "fourth");
+    }
+
+    // Test move (the handles keep working in the new map)
+    {
+        cave::SlotMap<cave::String> copy = map;
+        cave::SlotMap<cave::String> moved = std::move(copy);
+        assert(copy.size() == 0);
+        assert(moved.at(h4) == "fourth");
+
+        cave::SlotMap<cave::String> assigned;
+        assigned.insert("old");
+        assigned = std::move(moved);
+        assert(moved.size() == 0);
+        assert(!moved.contains(h4));
+        assert(assigned.size() == map.size());
+        assert(assigned.at(h4) == "fourth");
+
+        // The moved from maps are empty, but still usable.
+        auto h = moved.insert("new");
+        assert(moved.size() == 1 && moved.at(h) == "new");
+    }
+
+    std::cout << "[SLOT MAP] All tests passed!" << std::endl;
+}
+
+// Performance checks...
+
+#include <cstdio>
+#include <chrono>
+
+#include "Containers/HashMap.h"
+
+void testSlotMapPerformance() {
+    const int N = 100000;
+
+    std::cout << " - (We'll be testing it with " << N << " elements.)\n";
+
+    printf("          |  cave::HashMap | cave::SlotMap |\n");
+    size_t dur1 = 0;
+    size_t dur2 = 0;
+
+    cave::HashMap<int, int> m1;
+    cave::SlotMap<int> m2;
+    cave::Vector<cave::SlotMap<int>::Handle> handles;
+
+    // Test adding performance
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < N; i++) {
+        m1.insert(i, i);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+    dur1 = duration.count();
+
+    start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < N; i++) {
+        handles.pushBack(m2.insert(i));
+    }
+    end = std::chrono::high_resolution_clock::now();
+    duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+    dur2 = duration.count();
+    printf("   Adding | %11zu us | %10zu us |", dur1, dur2);
+    if (dur1 < dur2){ printf(" BAD!"); }
+    printf("\n");
+
+
+    // Test random access performance
+    start = std::chrono::high_resolution_clock::now();
+    long long count1 = 0;
+    for (int i = 0; i < N; i++) {
+        count1 += m1.at(i);
+    }
+    end = std::chrono::high_resolution_clock::now();
+    duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+    dur1 = duration.count();
+
+    start = std::chrono::high_resolution_clock::now();
+    long long count2 = 0;
+    for (int i = 0; i < N; i++) {
+        count2 += m2.at(handles[i]);
+    }
+    end = std::chrono::high_resolution_clock::now();
+    duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+    dur2 = duration.count();
+    printf("R. Access | %11zu us | %10zu us |", dur1, dur2);
+    if (dur1 < dur2){ printf(" BAD!"); }
+    printf("\n");
+
+    assert(count1 == count2); // Little assert just to make sure...
+
+
+    // Test removing performance
+    start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < N; i++) {
+        m1.erase(i);
+    }
+    end = std::chrono::high_resolution_clock::now();
+    duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+    dur1 = duration.count();
+
+    start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < N; i++) {
+        m2.erase(handles[i]);
+    }
+    end = std::chrono::high_resolution_clock::now();
+    duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+    dur2 = duration.count();
+    printf(" Removing | %11zu us | %10zu us |", dur1, dur2);
+    if (dur1 < dur2){ printf(" BAD!"); }
+    printf("\n");
+
+    assert(m1.empty() && m2.empty());
+}
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+
+#include "Containers/SoAVector.h"
+#include "Containers/String.h"
+#include "Containers/Exception.h"
+
+
+struct SoATestVec3 {
+    float x, y, z;
+};
+
+void testCaveSoAVector() {
+    std::cout << "[SOA VECTOR] Running tests...\n";
+
+    cave::SoAVector<SoATestVec3, int, cave::String> soa;
+    assert(soa.empty());
+    assert(soa.size() == 0);
+    assert(soa.capacity() == 0);
+    assert(soa.data<0>() == nullptr);
+
+    // Test pushBack and emplaceBack
+    for (int i=0; i<100; i++){
+        if (i % 2 == 0){
+            soa.pushBack(SoATestVec3{float(i), 0.0f, 0.0f}, i, cave::toString(i));
+        }
+        else {
+            soa.emplaceBack(SoATestVec3{float(i), 0.0f, 0.0f}, i, cave::toString(i).c_str());
+        }
+    }
+    assert(soa.size() == 100);
+    assert(soa.capacity() >= 100);
+
+    // Test the columns
+    for (size_t i=0; i<soa.size(); i++){
+        assert(soa.get<0>(i).x == float(i));
+        assert(soa.get<1>(i) == int(i));
+        assert(soa.get<2>(i) == cave::toString(i));
+    }
+    {
+        cave::Span<int> ids = soa.column<1>();
+        assert(ids.size() == 100);
+        int sum = 0;
+        for (int id : ids){
+            sum += id;
+        }
+        assert(sum == 4950);
+    }
+
+    // All the columns must be aligned
+    assert(uintptr_t(soa.data<0>()) % soa.columnAlignment == 0);
+    assert(uintptr_t(soa.data<1>()) % soa.columnAlignment == 0);
+    assert(uintptr_t(soa.data<2>()) % soa.columnAlignment == 0);
+
+    // Test at
+    assert(soa.at<1>(99) == 99);
+    try {
+        soa.at<1>(100);
+        assert(false);
+    } catch (cave::OutOfRangeException&) {
+        assert(true);
+    }
+
+    // Test erase (stable)
+    soa.erase(0);
+    assert(soa.size() == 99);
+    assert(soa.get<1>(0) == 1);
+    assert(soa.get<2>(0) == "1");
+    assert(soa.get<1>(98) == 99);
+
+    soa.erase(10, 20);
+    assert(soa.size() == 89);
+    assert(soa.get<1>(9) == 10);
+    assert(soa.get<1>(10) == 21);
+    assert(soa.get<2>(10) == "21");
+
+    // Test swapRemove
+    soa.swapRemove(0);
+    assert(soa.size() == 88);
+    assert(soa.get<1>(0) == 99);
+    assert(soa.get<0>(0).x == 99.0f);
+    assert(soa.get<2>(0) == "99");
+    soa.swapRemove(soa.size()); // Out of range: nothing happens.
+    soa.swapRemove(1000);
+    assert(soa.size() == 88);
+    assert(soa.get<1>(87) == 98);
+
+    // Test popBack
+    soa.popBack();
+    assert(soa.size() == 87);
+    assert(soa.get<1>(86) == 97);
+
+    // Test copy and move
+    {
+        cave::SoAVector<SoATestVec3, int, cave::String> copy = soa;
+        assert(copy.size() == soa.size());
+        for (size_t i=0; i<copy.size(); i++){
+            assert(copy.get<1>(i) == soa.get<1>(i));
+            assert(copy.get<2>(i) == soa.get<2>(i));
+        }
+
+        cave::SoAVector<SoATestVec3, int, cave::String> moved = std::move(copy);
+        assert(copy.empty());
+        assert(moved.size() == soa.size());
+        assert(moved.get<2>(0) == "99");
+    }
+
+    // Test resize, reserve, shrinkToFit and clear
+    soa.resize(200);
+    assert(soa.size() == 200);
+    assert(soa.get<1>(199) == 0);
+    assert(soa.get<2>(199).empty());
+    assert(soa.get<1>(0) == 99);
+
+    soa.resize(10);
+    assert(soa.size() == 10);
+    soa.shrinkToFit();
+    assert(soa.capacity() == soa.minAllocatedSlots);
+    assert(soa.get<2>(0) == "99");
+
+    soa.reserve(1000);
+    assert(soa.capacity() >= 1000);
+    assert(soa.get<2>(0) == "99");
+
+    soa.clear();
+    assert(soa.empty());
+
+    std::cout << "[SOA VECTOR] All tests passed!" << std::endl;
+}
@@ -0,0 +1,180 @@
+#pragma once
+
+#include <cassert>
+#include <iostream>
+
+#include "Containers/StableVector.h"
+#include "Containers/String.h"
+#include "Containers/Exception.h"
+
+
+void testCaveStableVector() {
+    std::cout << "[STABLE VECTOR] Running tests...\n";
+
+    cave::StableVector<int, 16> vec;
+    assert(vec.empty());
+    assert(vec.size() == 0);
+    assert(vec.capacity() == 0);
+
+    // Test pushBack and indexing across several chunks
+    for (int i=0; i<100; i++){
+        vec.pushBack(i);
+    }
+    assert(vec.size() == 100);
+    assert(vec.chunkCount() == 7);
+    assert(vec.capacity() == 7 * 16);
+    for (int i=0; i<100; i++){
+        assert(vec[i] == i);
+        assert(vec.at(i) == i);
+    }
+    assert(vec.front() == 0);
+    assert(vec.back() == 99);
+    try {
+        vec.at(100);
+        assert(false);
+    } catch (cave::OutOfRangeException&) {
+        assert(true);
+    }
+
+    // Test that growing never moves the elements
+    {
+        int* first = &vec[0];
+        int* last = &vec[99];
+        for (int i=100; i<10000; i++){
+            vec.pushBack(i);
+        }
+        assert(first == &vec[0] && *first == 0);
+        assert(last == &vec[99] && *last == 99);
+    }
+
+    // Test the iterators
+    {
+        long long sum = 0;
+        for (int e : vec){
+            sum += e;
+        }
+        assert(sum == 49995000);
+
+        auto it = vec.begin();
+        it += 20;
+        assert(*it == 20);
+        assert(it[5] == 25);
+        assert(vec.end() - vec.begin() == 10000);
+        assert(vec.begin() < it);
+
+        const cave::StableVector<int, 16>& cref = vec;
+        cave::StableVector<int, 16>::ConstIterator cit = cref.begin();
+        assert(*(cit + 3) == 3);
+    }
+
+    // Test popBack, resize and clear
+    vec.popBack();
+    assert(vec.size() == 9999);
+    assert(vec.back() == 9998);
+
+    vec.resize(10);
+    assert(vec.size() == 10);
+    vec.resize(40);
+    assert(vec.size() == 40);
+    assert(vec[39] == 0);
+
+    vec.shrinkToFit();
+    assert(vec.chunkCount() == 3);
+
+    vec.clear();
+    assert(vec.empty());
+    assert(vec.chunkCount() == 3);
+
+    // Test with non trivial objects, copy and move
+    {
+        cave::StableVector<cave::String, 4> strs = {"a", "b", "c", "d", "e"};
+        assert(strs.size() == 5);
+        assert(strs[4] == "e");
+        cave::String* ptr = &strs[1];
+
+        cave::StableVector<cave::String, 4> copy = strs;
+        assert(copy.size() == 5);
+        assert(copy[4] == "e");
+        assert(&copy[1] != ptr);
+
+        cave::StableVector<cave::String, 4> moved = std::move(strs);
+        assert(strs.empty());
+        assert(&moved[1] == ptr);
+        assert(moved.emplaceBack("f") == "f");
+        assert(moved.size() == 6);
+    }
+
+    std::cout << "[STABLE VECTOR] All tests passed!" << std::endl;
+}
+
+// Performance checks...
+
+#include <cstdio>
+#include <chrono>
+
+#include "Containers/Vector.h"
+
+void testStableVectorPerformance() {
+    const int N = 1000000;
+
+    std::cout << " - (We'll be testing it with " << N << " elements.)\n";
+
+    printf("            | cave::Vector | StableVector |\n");
+    size_t dur1 = 0;
+    size_t dur2 = 0;
+    size_t worst1 = 0;
+    size_t worst2 = 0;
+
+    cave::Vector<int> v1;
+    cave::StableVector<int> v2;
+
+    // Test adding performance (and the slowest single push, the reallocation spike)
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < N; i++) {
+        auto pushStart = std::chrono::high_resolution_clock::now();
+        v1.pushBack(i);
+        size_t pushDur = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - pushStart).count();
+        if (pushDur > worst1){ worst1 = pushDur; }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+    dur1 = duration.count();
+
+    start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < N; i++) {
+        auto pushStart = std::chrono::high_resolution_clock::now();
+        v2.pushBack(i);
+        size_t pushDur = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - pushStart).count();
+        if (pushDur > worst2){ worst2 = pushDur; }
+    }
+    end = std::chrono::high_resolution_clock::now();
+    duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+    dur2 = duration.count();
+    printf("     Adding | %9zu us | %9zu us |\n", dur1, dur2);
+    printf("Worst. Push | %9zu ns | %9zu ns |", worst1, worst2);
+    if (worst1 < worst2){ printf(" BAD!"); }
+    printf("\n");
+
+
+    // Test iteration performance
+    start = std::chrono::high_resolution_clock::now();
+    long long count1 = 0;
+    for (auto& i : v1) {
+        count1 += i;
+    }
+    end = std::chrono::high_resolution_clock::now();
+    duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+    dur1 = duration.count();
+
+    start = std::chrono::high_resolution_clock::now();
+    long long count2 = 0;
+    for (auto& i : v2) {
+        count2 += i;
+    }
+    end = std::chrono::high_resolution_clock::now();
+    duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+    dur2 = duration.count();
+    printf("  Iterating | %9zu us | %9zu us |\n", dur1, dur2);
+
+    assert(count1 == count2); // Little assert just to make sure...
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cassert>
+#include <iostream>
+
+#include "Containers/StaticVector.h"
+#include "Containers/String.h"
+#include "Containers/Exception.h"
+
+
+void testCaveStaticVector() {
+    std::cout << "[STATIC VECTOR] Running tests...\n";
+
+    cave::StaticVector<int, 8> vec;
+    assert(vec.empty());
+    assert(vec.capacity() == 8);
+
+    // The storage is inside the object (no heap):
+    const char* obj = (const char*)&vec;
+    assert((const char*)vec.data() >= obj && (const char*)vec.data() < obj + sizeof(vec));
+
+    // Test pushBack, emplaceBack and access
+    for (int i=0; i<8; i++){
+        vec.pushBack(i * 10);
+    }
+    assert(vec.size() == 8);
+    assert(vec.full());
+    assert(vec.front() == 0);
+    assert(vec.back() == 70);
+    assert(vec[3] == 30);
+    try {
+        vec.at(8);
+        assert(false);
+    } catch (cave::OutOfRangeException&) {
+        assert(true);
+    }
+
+    // Test iteration and find
+    {
+        int sum = 0;
+        for (int e : vec){
+            sum += e;
+        }
+        assert(sum == 280);
+        assert(vec.findID(50) == 5);
+        assert(!vec.contains(55));
+    }
+
+    // Test erase
+    vec.erase(0);
+    assert(vec.size() == 7);
+    assert(vec.front() == 10);
+    vec.erase(1);
+    assert(vec[1] == 30);
+    vec.eraseUnordered(0);
+    assert(vec.size() == 5);
+    assert(vec[0] == 70);
+    vec.eraseUnordered(5); // Out of range: nothing happens.
+    assert(vec.size() == 5);
+    vec.erase(1, 3);
+    assert(vec.size() == 3);
+
+    // Test sort
+    vec.sort();
+    assert(vec[0] < vec[1] && vec[1] < vec[2]);
+    vec.sort([](int a, int b){ return a > b; });
+    assert(vec[0] > vec[1] && vec[1] > vec[2]);
+
+    // Test resize, popBack and clear
+    vec.resize(6);
+    assert(vec.size() == 6 && vec[5] == 0);
+    vec.popBack();
+    assert(vec.size() == 5);
+    vec.clear();
+    assert(vec.empty());
+
+    // Test the overflow policy
+    {
+        cave::StaticVector<int, 2, cave::OverflowPolicy::Throw> small = {1, 2};
+        try {
+            small.pushBack(3);
+            assert(false);
+        } catch (cave::OutOfRangeException&) {
+            assert(true);
+        }
+        assert(small.size() == 2);
+        try {
+            small.resize(3);
+            assert(false);
+        } catch (cave::OutOfRangeException&) {
+            assert(true);
+        }
+    }
+
+    // Test non trivial types, copying and moving
+    {
+        cave::StaticVector<cave::String, 4> strs = {"cave", "engine"};
+        cave::StaticVector<cave::String, 4> copy = strs;
+        assert(copy == strs);
+        assert(copy.emplaceBack("rocks") == "rocks");
+
+        cave::StaticVector<cave::String, 4> moved = std::move(copy);
+        assert(copy.empty());
+        assert(moved.size() == 3);
+        assert(moved[2] == "rocks");
+
+        strs = moved;
+        assert(strs == moved);
+        strs.erase(0);
+        assert(strs[0] == "engine");
+        strs = std::move(moved);
+        assert(strs.size() == 3 && moved.empty());
+    }
+
+    std::cout << "[STATIC VECTOR] All tests passed!" << std::endl;
+}
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <cassert>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include "Containers/StringBuilder.h"
+#include "Containers/String.h"
+
+
+void testCaveStringBuilder() {
+    std::cout << "[STRING BUILDER] Running tests...\n";
+
+    // Test concatenating with operator+ (temporaries are reused)
+    {
+        const cave::String folder = "textures";
+        const cave::String file = "wall_diffuse_with_a_long_name";
+        cave::String path = cave::String("assets/") + folder + '/' + file + ".png";
+        assert(path == "assets/textures/wall_diffuse_with_a_long_name.png");
+        assert("../" + folder == "../textures");
+        assert(folder + cave::StringView("/sub") == "textures/sub");
+        assert(cave::StringView("root/") + folder == "root/textures");
+        assert(folder + "" == folder);
+
+        // Mixed with std::string (these used to be ambiguous):
+        const std::string sub = "/sub";
+        assert(folder + sub == "textures/sub");
+        assert(std::string("root/") + folder == "root/textures");
+        assert(cave::String("assets/") + folder + sub == "assets/textures/sub");
+    }
+
+    // Test cave::concat
+    {
+        const cave::String name = "hero";
+        cave::StringView ext = ".fbx";
+        cave::String path = cave::concat("assets/models/", name, '_', "lod0", ext);
+        assert(path == "assets/models/hero_lod0.fbx");
+        assert(cave::concat().empty());
+        assert(cave::concat(name) == name);
+    }
+
+    // Test the builder
+    {
+        cave::StringBuilder sb;
+        assert(sb.empty());
+        sb << "frame " << '#' << cave::String("42") << cave::StringView(": ok");
+        sb.append(3, '!');
+        assert(sb.view() == "frame #42: ok!!!");
+        assert(strcmp(sb.c_str(), "frame #42: ok!!!") == 0);
+        sb << " (and long enough for the heap)";
+        assert(sb.capacity() == cave::StringBuilder::minChunk);
+
+        const char* buffer = sb.c_str();
+        cave::String built = sb.build();
+        assert(built == "frame #42: ok!!! (and long enough for the heap)");
+        assert(built.c_str() == buffer); // Handed over, not copied!
+        assert(sb.empty());
+
+        // Reusing it:
+        for (int i=0; i<1000; i++){
+            sb.append("line\n");
+        }
+        assert(sb.size() == 5000);
+        assert(sb.capacity() >= sb.size());
+        const size_t capacity = sb.capacity();
+        sb.clear();
+        assert(sb.empty() && sb.capacity() == capacity);
+    }
+
+    std::cout << "[STRING BUILDER] All tests passed!" << std::endl;
+}
+
+// Performance checks...
+
+#include <cstdio>
+#include <chrono>
+#include <string>
+
+void testStringBuilderPerformance() {
+    const int N = 100000;
+
+    std::cout << " - (We'll be building " << N << " paths with 5 parts.)\n";
+
+    const std::string root1 = "assets/models/characters";
+    const std::string name1 = "hero_with_a_long_name";
+    const cave::String root2 = "assets/models/characters";
+    const cave::String name2 = "hero_with_a_long_name";
+
+    printf("          | std::string | cave::String | cave::concat | StringBuilder |\n");
+    size_t dur1 = 0;
+    size_t dur2 = 0;
+    size_t dur3 = 0;
+    size_t dur4 = 0;
+    size_t total1 = 0;
+    size_t total2 = 0;
+    size_t total3 = 0;
+    size_t total4 = 0;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < N; i++) {
+        std::string path = root1 + "/" + name1 + "/" + "mesh.fbx";
+        total1 += path.size();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    dur1 = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+    start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < N; i++) {
+        cave::String path = root2 + "/" + name2 + "/" + "mesh.fbx";
+        total2 += path.size();
+    }
+    end = std::chrono::high_resolution_clock::now();
+    dur2 = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+    start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < N; i++) {
+        cave::String path = cave::concat(root2, "/", name2, "/", "mesh.fbx");
+        total3 += path.size();
+    }
+    end = std::chrono::high_resolution_clock::now();
+    dur3 = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+    cave::StringBuilder sb;
+    start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < N; i++) {
+        sb.clear();
+        sb << root2 << '/' << name2 << '/' << "mesh.fbx";
+        total4 += sb.size();
+    }
+    end = std::chrono::high_resolution_clock::now();
+    dur4 = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+    printf(" Building | %8zu us | %9zu us | %9zu us | %10zu us |", dur1, dur2, dur3, dur4);
+    if (dur1 < dur2 || dur1 < dur3){ printf(" BAD!"); }
+    printf("\n");
+
+    assert(total1 == total2 && total1 == total3 && total1 == total4); // Little assert just to make sure...
+}
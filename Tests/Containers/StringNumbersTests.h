@@ -0,0 +1,216 @@
+#pragma once
+
+#include <cassert>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <cmath> // std::isnan
+#include <clocale> // setlocale
+
+#include "Containers/StringNumbers.h"
+#include "Containers/StringBuilder.h"
+#include "Containers/String.h"
+
+
+void testCaveStringNumbers() {
+    std::cout << "[STRING NUMBERS] Running tests...\n";
+
+    // Test formatting integers
+    assert(cave::toString(0) == "0");
+    assert(cave::toString(7) == "7");
+    assert(cave::toString(42) == "42");
+    assert(cave::toString(-42) == "-42");
+    assert(cave::toString(100) == "100");
+    assert(cave::toString(123456789) == "123456789");
+    assert(cave::toString(std::numeric_limits<int>::min()) == "-2147483648");
+    assert(cave::toString(std::numeric_limits<unsigned int>::max()) == "4294967295");
+    assert(cave::toString(std::numeric_limits<long long>::min()) == "-9223372036854775808");
+    assert(cave::toString(std::numeric_limits<unsigned long long>::max()) == "18446744073709551615");
+    {
+        // Every digit count against std:
+        unsigned long long v = 1;
+        for (int i=0; i<19; i++){
+            assert(cave::toString(v) == std::to_string(v).c_str());
+            assert(cave::toString(v - 1) == std::to_string(v - 1).c_str());
+            v *= 10;
+        }
+    }
+
+    // Test formatting floats (shortest round trip)
+    assert(cave::toString(0.1) == "0.1");
+    assert(cave::toString(0.1f) == "0.1");
+    assert(cave::toString(1.0f) == "1");
+    assert(cave::toString(-2.5) == "-2.5");
+    assert(cave::toString(1e21) == "1e+21");
+    assert(cave::toString(std::numeric_limits<double>::infinity()) == "inf");
+    {
+        const double values[] = {3.141592653589793, 1.0 / 3.0, 123456.789, 5e-324, 1.7976931348623157e308};
+        for (double value : values){
+            double parsed = 0.0;
+            assert(cave::parseNumber(cave::toString(value), parsed));
+            assert(parsed == value);
+        }
+        const float fvalue = 0.3f;
+        float fparsed = 0.0f;
+        assert(cave::parseNumber(cave::toString(fvalue), fparsed));
+        assert(fparsed == fvalue);
+
+        // long double (it used to be ambiguous):
+        assert(cave::toString(1.5L) == "1.5");
+        const long double lvalues[] = {1.0L / 3.0L, -0.1L, std::numeric_limits<long double>::max(),
+            std::numeric_limits<long double>::denorm_min()};
+        for (long double value : lvalues){
+            long double parsed = 0.0L;
+            assert(cave::parseNumber(cave::toString(value), parsed));
+            assert(parsed == value);
+        }
+    }
+
+    // Test appending (and the StringBuilder)
+    {
+        cave::String line = "pos: ";
+        cave::appendNumber(line, 10);
+        line += ' ';
+        cave::appendNumber(line, -0.5f);
+        assert(line == "pos: 10 -0.5");
+
+        cave::StringBuilder sb;
+        sb << "v " << 1.5f << ' ' << 2 << ' ' << -3.25 << ' ' << size_t(7) << ' ' << true << ' ' << 0.75L;
+        assert(sb.view() == "v 1.5 2 -3.25 7 true 0.75");
+    }
+
+    // Test parsing
+    {
+        int i = 0;
+        assert(cave::parseNumber("123", i) && i == 123);
+        assert(cave::parseNumber("-123", i) && i == -123);
+        assert(cave::parseNumber("+5", i) && i == 5);
+        assert(!cave::parseNumber("", i) && i == 5);
+        assert(!cave::parseNumber("12a", i));
+        assert(!cave::parseNumber(" 12", i));
+        assert(!cave::parseNumber("+-1", i));
+        assert(!cave::parseNumber("2147483648", i));
+        assert(i == 5);
+        assert(cave::parseNumber(cave::StringView("4096 bytes").substr(0, 4), i) && i == 4096);
+
+        unsigned int u = 0;
+        assert(cave::parseNumber("4294967295", u) && u == 4294967295u);
+        assert(!cave::parseNumber("-1", u));
+
+        long long ll = 0;
+        assert(cave::parseNumber("-9223372036854775808", ll) && ll == std::numeric_limits<long long>::min());
+
+        double d = 0.0;
+        assert(cave::parseNumber("3.5", d) && d == 3.5);
+        assert(cave::parseNumber("-1e-3", d) && d == -1e-3);
+        assert(cave::parseNumber("+.5", d) && d == 0.5);
+        assert(cave::parseNumber("inf", d) && d == std::numeric_limits<double>::infinity());
+        assert(cave::parseNumber("nan", d) && std::isnan(d));
+        assert(!cave::parseNumber("1.5f", d));
+        assert(!cave::parseNumber("1e999", d));
+        assert(!cave::parseNumber(".", d));
+
+        float f = 0.0f;
+        assert(cave::parseNumber(cave::String("  0.25 ").trimView(), f) && f == 0.25f);
+
+        long double ld = 0.0L;
+        assert(cave::parseNumber("-2.5", ld) && ld == -2.5L);
+        assert(!cave::parseNumber("0x1p3", ld));
+        assert(!cave::parseNumber("1,5", ld));
+        // There's no limit on the size (this one doesn't fit strtold's stack buffer):
+        cave::String longFraction = "0.5";
+        for (int k=0; k<200; k++){
+            longFraction += '0';
+        }
+        assert(cave::parseNumber(longFraction, ld) && ld == 0.5L);
+        assert(cave::parseNumber(longFraction, d) && d == 0.5);
+
+        // Always a '.', whatever the C locale is (when one with a ',' is installed):
+        const char* commaLocales[] = {"de_DE.UTF-8", "de_DE.utf8", "fr_FR.UTF-8", "pt_BR.UTF-8"};
+        for (const char* name : commaLocales){
+            if (setlocale(LC_NUMERIC, name) == nullptr){
+                continue;
+            }
+            assert(cave::parseNumber("1.5", ld) && ld == 1.5L);
+            assert(!cave::parseNumber("1,5", ld));
+            assert(cave::parseNumber("1.5", d) && d == 1.5);
+            assert(cave::toString(1.5L) == "1.5");
+            break;
+        }
+        setlocale(LC_NUMERIC, "C");
+    }
+
+    std::cout << "[STRING NUMBERS] All tests passed!" << std::endl;
+}
+
+// Performance checks...
+
+#include <cstdio>
+#include <chrono>
+#include <cstdlib> // atof
+#include <string>
+
+void testStringNumbersPerformance() {
+    const int N = 200000;
+
+    std::cout << " - (We'll be testing it with " << N << " numbers.)\n";
+
+    printf("          | std::to_string, atof | cave::appendNumber, parseNumber |\n");
+    size_t dur1 = 0;
+    size_t dur2 = 0;
+
+    // Test formatting (integers and floats, like a text exporter)
+    std::string out1;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < N; i++) {
+        out1 += std::to_string(i * 7919);
+        out1 += ' ';
+        out1 += std::to_string(float(i) * 0.25f);
+        out1 += '\n';
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    dur1 = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+    cave::String out2;
+    start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < N; i++) {
+        cave::appendNumber(out2, i * 7919);
+        out2 += ' ';
+        cave::appendNumber(out2, float(i) * 0.25f);
+        out2 += '\n';
+    }
+    end = std::chrono::high_resolution_clock::now();
+    dur2 = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    printf("   Format | %17zu us | %28zu us |", dur1, dur2);
+    if (dur1 < dur2){ printf(" BAD!"); }
+    printf("\n");
+
+    // Test parsing (every float written above)
+    double sum1 = 0.0;
+    start = std::chrono::high_resolution_clock::now();
+    for (cave::StringView line : out2.splitView('\n')) {
+        const size_t space = line.find(' ');
+        if (space != cave::StringView::npos){
+            sum1 += atof(cave::String(line.substr(space + 1)).c_str());
+        }
+    }
+    end = std::chrono::high_resolution_clock::now();
+    dur1 = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+    double sum2 = 0.0;
+    start = std::chrono::high_resolution_clock::now();
+    for (cave::StringView line : out2.splitView('\n')) {
+        const size_t space = line.find(' ');
+        float value = 0.0f;
+        if (space != cave::StringView::npos && cave::parseNumber(line.substr(space + 1), value)){
+            sum2 += value;
+        }
+    }
+    end = std::chrono::high_resolution_clock::now();
+    dur2 = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    printf("    Parse | %17zu us | %28zu us |", dur1, dur2);
+    if (dur1 < dur2){ printf(" BAD!"); }
+    printf("\n");
+
+    assert(sum1 == sum2); // Little assert just to make sure...
+}
@@ -3,6 +3,8 @@
 #include <cassert>
 #include <cstring>
 #include <iostream>
+#include <algorithm> // std::find
+#include <string>
 
 #include "Containers/String.h"
 #include "Containers/StringHash.h"
@@ -137,6 +139,56 @@ void testCaveString() {
     s6.erase(6, 10);
     assert(s6 == "hello moon");
 
+    // Test editing in place (growing, aliasing and out of range positions)
+    {
+        cave::String edit = "0123456789";
+        edit.replace(2, 3, "ab");
+        assert(edit == "01ab56789");
+        edit.replace(0, 0, cave::StringView("xyz"));
+        assert(edit == "xyz01ab56789");
+        edit.insert(edit.size(), " and a tail long enough to leave the local buffer");
+        assert(edit.endsWith("local buffer") && edit.startsWith("xyz01"));
+        edit.erase(3);
+        assert(edit == "xyz");
+        edit.insert(1, edit);
+        assert(edit == "xxyzyz");
+        edit.replace(0, 2, edit.substrView(2, 4));
+        assert(edit == "yzyzyzyz");
+        edit.erase(100, 5);
+        edit.replace(100, 0, "!");
+        assert(edit == "yzyzyzyz!");
+        edit.erase(1, 1000);
+        assert(edit == "y");
+        edit.erase();
+        assert(edit.empty());
+    }
+
+    // Test replaceAll() method
+    {
+        cave::String src = "#define PI 3.14\nfloat x = PI * 2.0; float y = PI;";
+        assert(src.replaceAll("PI", "3.14159") == 3);
+        assert(src == "#define 3.14159 3.14\nfloat x = 3.14159 * 2.0; float y = 3.14159;");
+        assert(src.replaceAll("3.14159", "P") == 3);
+        assert(src == "#define P 3.14\nfloat x = P * 2.0; float y = P;");
+        assert(src.replaceAll(" ", "") == 11);
+        assert(src == "#defineP3.14\nfloatx=P*2.0;floaty=P;");
+        assert(src.replaceAll("missing", "x") == 0);
+        assert(src.replaceAll("", "x") == 0);
+
+        cave::String overlap = "aaaaa";
+        assert(overlap.replaceAll("aa", "b") == 2);
+        assert(overlap == "bba");
+        overlap = "aaaaa";
+        assert(overlap.replaceAll("aa", "aaa") == 2);
+        assert(overlap == "aaaaaaa");
+
+        cave::String self = "abcabc";
+        assert(self.replaceAll(self.substrView(0, 3), self.substrView(3, 3) ) == 2);
+        assert(self == "abcabc");
+        assert(self.replaceAll(self.substrView(0, 1), self) == 2);
+        assert(self == "abcabcbcabcabcbc");
+    }
+
     // Test compare() method
     assert(s6.compare("hello moon") == 0);
     assert(s6.compare("goodbye moon") > 0);
@@ -145,6 +197,72 @@ void testCaveString() {
     // Test rfind() method
     cave::String s7 = "hello world world world worlld worl";
     assert(s7.rfind("world") == 18);
+    assert(s7.rfind("world", 17) == 12);
+    assert(s7.rfind("hello") == 0);
+    assert(s7.rfind("moon") == cave::String::npos);
+    assert(cave::String().rfind("a") == cave::String::npos);
+    assert(cave::String().rfind("") == 0);
+
+    // Test find() bounds and the sizes being taken into account
+    assert(s7.find("world", 7) == 12);
+    assert(s7.find("world", 1000) == cave::String::npos);
+    assert(s7.find("", s7.size()) == s7.size());
+    {
+        cave::String withNull("abc");
+        withNull.pushBack('\0');
+        withNull.append("def");
+        assert(withNull.size() == 7);
+        assert(withNull != "abc");
+        assert(withNull.compare("abc") > 0);
+        assert(withNull.find("def") == 4);
+        assert(withNull.rfind(cave::StringView("c\0d", 3)) == 2);
+    }
+    assert(cave::String("abc") < cave::String("abcd"));
+    assert(cave::String("abd") > cave::String("abcd"));
+
+    // Test searching long (SIMD) strings against std::string
+    {
+        const char* alphabets[] = {"ab", "abc", "abcdefghij"};
+        unsigned int seed = 42;
+        for (const char* alphabet : alphabets){
+            const size_t letters = strlen(alphabet);
+            for (int round=0; round<60; round++){
+                std::string text;
+                std::string needle;
+                seed = seed * 1103515245u + 12345u;
+                const size_t textSize = seed % 300;
+                const size_t needleSize = 1 + (seed >> 16) % 9;
+                for (size_t i=0; i<textSize; i++){
+                    seed = seed * 1103515245u + 12345u;
+                    text += alphabet[(seed >> 16) % letters];
+                }
+                for (size_t i=0; i<needleSize; i++){
+                    seed = seed * 1103515245u + 12345u;
+                    needle += alphabet[(seed >> 16) % letters];
+                }
+                const cave::String cText(text);
+                const cave::String cNeedle(needle);
+                for (size_t pos=0; pos<=textSize; pos += 7){
+                    assert(cText.find(cNeedle, pos) == text.find(needle, pos));
+                    assert(cText.rfind(cNeedle, pos) == text.rfind(needle, pos));
+                }
+                assert(cText.rfind(cNeedle) == text.rfind(needle));
+            }
+        }
+
+        // Very repetitive text (the filter gives up and Two-Way takes over)
+        std::string text(5000, 'a');
+        std::string needle = std::string(40, 'a') + "b";
+        assert(cave::String(text).find(cave::String(needle)) == cave::String::npos);
+        assert(cave::String(text).rfind(cave::String(needle)) == cave::String::npos);
+        text[3000] = 'b';
+        assert(cave::String(text).find(cave::String(needle)) == text.find(needle));
+        needle = "b" + std::string(40, 'a');
+        assert(cave::String(text).rfind(cave::String(needle)) == text.rfind(needle));
+        text[4990] = 'b';
+        assert(cave::String(text).rfind(cave::String(needle)) == text.rfind(needle));
+        assert(cave::String(text).find(cave::String("ab")) == 2999);
+    }
 
 //    // Test swap() method
 //    cave::String s8 = "goodbye";
@@ -174,6 +292,103 @@ void testCaveString() {
     sPush2.popBack();
     assert(sPush2 == "");
 
+    // Test the small string optimization
+    {
+        cave::String small = "short name";
+        const char* obj = (const char*)&small;
+        assert(small.data() >= obj && small.data() < obj + sizeof(small));
+        assert(small.capacity() == cave::String::localCapacity);
+
+        cave::String local(cave::String("0123456789012345678901")); // 22 chars
+        assert(local.capacity() == cave::String::localCapacity);
+        local += 'x';
+        assert(local.capacity() > cave::String::localCapacity);
+        assert(local == "0123456789012345678901x");
+        const char* localObj = (const char*)&local;
+        assert(local.data() < localObj || local.data() >= localObj + sizeof(local));
+        local.reserve(1000);
+        assert(local.capacity() >= 1000 && local.capacity() < 2000);
+        assert(local == "0123456789012345678901x");
+
+        // Moving local and heap strings around:
+        cave::String moved = std::move(small);
+        assert(moved == "short name" && small.empty() && strcmp(small.c_str(), "") == 0);
+        cave::String heap = std::move(local);
+        assert(heap == "0123456789012345678901x" && local.empty());
+        moved = std::move(heap);
+        assert(moved.size() == 23 && heap.empty());
+        heap = "tiny";
+        moved = std::move(heap);
+        assert(moved == "tiny" && moved.capacity() == cave::String::localCapacity);
+
+        // Growth is geometric, and reserve keeps the contents:
+        cave::String grow;
+        size_t reallocs = 0;
+        size_t lastCapacity = grow.capacity();
+        for (int i=0; i<10000; i++){
+            grow += 'a';
+            if (grow.capacity() != lastCapacity){
+                reallocs++;
+                lastCapacity = grow.capacity();
+            }
+        }
+        assert(reallocs < 20);
+        assert(grow.size() == 10000 && grow.capacity() >= 10000);
+
+        // Appending/assigning a string to itself:
+        cave::String self = "abc";
+        self.append(self);
+        assert(self == "abcabc");
+        for (int i=0; i<4; i++){
+            self.append(self.c_str(), self.size());
+        }
+        assert(self.size() == 96 && self.substr(90) == "abcabc");
+        self.assign(self.c_str() + 3, 3);
+        assert(self == "abc");
+    }
+
+    // Test the views
+    {
+        cave::String line = "  key = some value  ";
+        cave::StringView trimmed = line.trimView();
+        assert(trimmed == "key = some value");
+        assert(trimmed.data() == line.data() + 2);
+
+        size_t eq = line.find(cave::StringView("="));
+        assert(eq == 6);
+        assert(line.substrView(2, 3) == "key");
+
+        cave::String path = "assets/textures/wall.png";
+        size_t parts = 0;
+        for (cave::StringView part : path.splitView('/')){
+            assert(!part.empty());
+            parts++;
+        }
+        assert(parts == 3);
+        assert(path.startsWith("assets/") && path.endsWith(".png"));
+        assert(path.rfind(cave::StringView("/")) == 15);
+
+        // Strings from views, views from strings:
+        cave::String fromView(path.substrView(7, 8));
+        assert(fromView == "textures");
+        cave::StringView asView = fromView;
+        assert(asView == fromView && fromView == asView);
+        fromView = path.substrView(16);
+        assert(fromView == "wall.png");
+        fromView += cave::StringView(".bak");
+        assert(fromView == "wall.png.bak");
+        assert(fromView.compare(cave::StringView("wall")) > 0);
+    }
+
+    // Test iterating (even when empty)
+    {
+        cave::String empty;
+        assert(empty.begin() == empty.end());
+        const cave::String it = "cave";
+        cave::String::ConstIterator c = std::find(it.begin(), it.end(), 'v');
+        assert(c - it.begin() == 2);
+    }
+
     // Test string hashing...
     cave::String hashTest = "hmmm";
     auto hs = std::hash<cave::String>{}(hashTest);
@@ -272,6 +487,103 @@ void testStringPerformance() {
     }
 
 
+    {
+        // Test creating lots of short strings (names, tags, keys...)
+        size_t total1 = 0;
+        start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < N; i++) {
+            std::string name("entity_name");
+            name += 'a' + (i % 26);
+            total1 += name.size();
+        }
+        end = std::chrono::high_resolution_clock::now();
+        duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+        dur1 = duration.count();
+
+        size_t total2 = 0;
+        start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < N; i++) {
+            cave::String name("entity_name");
+            name += char('a' + (i % 26));
+            total2 += name.size();
+        }
+        end = std::chrono::high_resolution_clock::now();
+        duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+        dur2 = duration.count();
+        printf("    Short | %9zu us | %9zu us |", dur1, dur2);
+        if (dur1 < dur2){ printf(" BAD!"); }
+        printf("\n");
+
+        assert(total1 == total2); // Little assert just to make sure...
+    }
+
+    {
+        // Test searching performance (like filtering a big log)
+        std::string log1;
+        for (int i = 0; i < N; i++) {
+            log1 += "[info] frame ";
+            log1 += char('0' + (i % 10));
+            log1 += " rendered\n";
+        }
+        log1 += "[error] shader failed\n";
+        const cave::String log2(log1);
+
+        size_t found1 = 0;
+        start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < 20; i++) {
+            found1 += log1.find("[error]") + log1.rfind("[info] frame 7");
+        }
+        end = std::chrono::high_resolution_clock::now();
+        duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+        dur1 = duration.count();
+
+        size_t found2 = 0;
+        start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < 20; i++) {
+            found2 += log2.find("[error]") + log2.rfind("[info] frame 7");
+        }
+        end = std::chrono::high_resolution_clock::now();
+        duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+        dur2 = duration.count();
+        printf("     Find | %9zu us | %9zu us |", dur1, dur2);
+        if (dur1 < dur2){ printf(" BAD!"); }
+        printf("\n");
+
+        assert(found1 == found2); // Little assert just to make sure...
+    }
+
+    {
+        // Test editing in the middle (like a macro substitution)
+        std::string text1(2000, 'x');
+        cave::String text2(text1);
+
+        start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < N; i++) {
+            const size_t pos = (i * 37) % 1900;
+            text1.replace(pos, 4, "MACRO");
+            text1.erase(pos, 1);
+        }
+        end = std::chrono::high_resolution_clock::now();
+        duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+        dur1 = duration.count();
+
+        start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < N; i++) {
+            const size_t pos = (i * 37) % 1900;
+            text2.replace(pos, 4, "MACRO");
+            text2.erase(pos, 1);
+        }
+        end = std::chrono::high_resolution_clock::now();
+        duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+        dur2 = duration.count();
+        printf("  Replace | %9zu us | %9zu us |", dur1, dur2);
+        if (dur1 < dur2){ printf(" BAD!"); }
+        printf("\n");
+
+        assert(text2 == text1.c_str()); // Little assert just to make sure...
+    }
+
+
     // Test removing performance
     start = std::chrono::high_resolution_clock::now();
     for (int i = 0; i < N; i++) {
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cassert>
+#include <cstring>
+#include <iostream>
+#include <functional>
+
+#include "Containers/StringView.h"
+#include "Containers/String.h"
+#include "Containers/StringHash.h"
+#include "Containers/Exception.h"
+
+
+void testCaveStringView() {
+    std::cout << "[STRING VIEW] Running tests...\n";
+
+    cave::StringView empty;
+    assert(empty.empty());
+    assert(empty.size() == 0);
+    assert(empty == "");
+
+    // Test construction and comparison
+    cave::StringView v1 = "hello world";
+    assert(v1.size() == 11);
+    assert(v1 == "hello world");
+    assert(v1 != "hello");
+    assert(v1.front() == 'h' && v1.back() == 'd');
+    assert(v1[4] == 'o');
+    try {
+        v1.at(11);
+        assert(false);
+    } catch (cave::OutOfRangeException&) {
+        assert(true);
+    }
+    assert(cave::StringView("abc") < cave::StringView("abd"));
+    assert(cave::StringView("ab") < cave::StringView("abc"));
+    assert(cave::StringView("b").compare("abc") > 0);
+
+    // Test slicing (it's not null terminated!)
+    cave::StringView world = v1.substr(6);
+    assert(world == "world");
+    assert(world.data() == v1.data() + 6);
+    cave::StringView hello = v1.substr(0, 5);
+    assert(hello == "hello" && hello.size() == 5);
+    assert(v1.substr(100).empty());
+
+    cave::StringView trimmed = cave::StringView("  \t value \n").trim();
+    assert(trimmed == "value");
+    assert(cave::StringView("   ").trim().empty());
+
+    cave::StringView prefixed = "prefix_name";
+    prefixed.removePrefix(7);
+    assert(prefixed == "name");
+    prefixed.removeSuffix(2);
+    assert(prefixed == "na");
+
+    // Test searching
+    assert(v1.find('o') == 4);
+    assert(v1.find('o', 5) == 7);
+    assert(v1.find('z') == cave::StringView::npos);
+    assert(v1.find("world") == 6);
+    assert(v1.find("worlds") == cave::StringView::npos);
+    assert(v1.find("") == 0);
+    assert(v1.rfind('o') == 7);
+    assert(v1.rfind("o", 6) == 4);
+    assert(v1.startsWith("hello") && !v1.startsWith("world"));
+    assert(v1.endsWith("world") && !v1.endsWith("hello"));
+    assert(v1.contains("lo wo"));
+    // It must not read past the end of the view:
+    assert(hello.find("hello w") == cave::StringView::npos);
+
+    // Test splitting
+    {
+        const char* expected[] = {"assets", "models", "", "hero.fbx"};
+        size_t n = 0;
+        for (cave::StringView part : cave::StringView("assets/models//hero.fbx").split('/')){
+            assert(part == expected[n++]);
+        }
+        assert(n == 4);
+
+        n = 0;
+        for (cave::StringView part : cave::StringView("single").split(',')){
+            assert(part == "single");
+            n++;
+        }
+        assert(n == 1);
+    }
+
+    // Test hashing (the same as String and std::string)
+    assert(std::hash<cave::StringView>{}(hello) == std::hash<cave::String>{}(cave::String("hello")));
+    assert(std::hash<cave::StringView>{}(hello) == std::hash<std::string>{}(std::string("hello")));
+
+    std::cout << "[STRING VIEW] All tests passed!" << std::endl;
+}
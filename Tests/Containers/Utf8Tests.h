@@ -0,0 +1,303 @@
+#pragma once
+
+#include <cassert>
+#include <cstring>
+#include <iostream>
+#include <random>
+
+#include "Containers/Utf8.h"
+#include "Containers/String.h"
+#include "Containers/Vector.h"
+
+
+// Reference check for the randomized tests: a text is valid UTF-8 if decoding
+// it and encoding every code point back gives the exact same bytes (invalid
+// bytes turn into U+FFFD, which is encoded differently).
+inline bool utf8TestRoundTrips(const cave::String& text) {
+    cave::String encoded;
+    for (char32_t c : text.codePoints()){
+        cave::utf8::appendCodePoint(encoded, c);
+    }
+    return encoded == text;
+}
+
+void testCaveUtf8() {
+    std::cout << "[UTF8] Running tests...\n";
+
+    // "aé€😀": 1, 2, 3 and 4 bytes.
+    const cave::String mixed = "a\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80";
+    assert(mixed.size() == 10);
+
+    // Test validation
+    assert(cave::String().isValidUtf8());
+    assert(cave::String("plain ascii").isValidUtf8());
+    assert(mixed.isValidUtf8());
+    {
+        const char* invalid[] = {
+            "\x80",             // A lonely continuation byte.
+            "\xC3",             // Truncated.
+            "\xE2\x82",         // Truncated.
+            "\xC0\xAF",         // Overlong '/'.
+            "\xE0\x80\xAF",     // Overlong '/'.
+            "\xF0\x80\x80\xAF", // Overlong '/'.
+            "\xED\xA0\x80",     // A surrogate (U+D800).
+            "\xF4\x90\x80\x80", // Above U+10FFFF.
+            "\xF5\x80\x80\x80", // Not a lead byte.
+            "\xFF",
+            "\xC3\x28",         // Not a continuation byte.
+        };
+        for (const char* str : invalid){
+            assert(!cave::String(str).isValidUtf8());
+            // Also in the middle of a long ascii text (the SIMD path):
+            cave::String longer = "0123456789012345678901234567890123456789";
+            longer += str;
+            longer += "0123456789012345678901234567890123456789";
+            assert(!longer.isValidUtf8());
+        }
+        assert(cave::utf8::isValid("\xF4\x8F\xBF\xBF"));   // U+10FFFF
+        assert(cave::utf8::isValid("\xEF\xBF\xBD"));       // U+FFFD itself.
+        assert(cave::utf8::isValid("\xED\x9F\xBF"));       // U+D7FF
+    }
+
+    // Test decoding and iterating
+    {
+        char32_t c = 0;
+        assert(cave::utf8::decode("\xE2\x82\xAC", 3, c) == 3 && c == 0x20AC);
+        assert(cave::utf8::decode("\xE2\x82", 2, c) == 1 && c == cave::utf8::replacementChar);
+
+        const char32_t expected[] = {U'a', 0xE9, 0x20AC, 0x1F600};
+        size_t i = 0;
+        for (char32_t cp : mixed.codePoints()){
+            assert(cp == expected[i]);
+            i++;
+        }
+        assert(i == 4);
+        assert(mixed.codePointCount() == 4);
+
+        auto it = mixed.codePoints().begin();
+        ++it;
+        assert(it.position() == mixed.c_str() + 1 && it.sequenceSize() == 2);
+
+        // Every invalid byte is one replacement char:
+        const cave::String broken = "a\x80\x80" "b\xE2\x82";
+        const char32_t brokenExpected[] = {U'a', 0xFFFD, 0xFFFD, U'b', 0xFFFD, 0xFFFD};
+        i = 0;
+        for (char32_t cp : broken.codePoints()){
+            assert(cp == brokenExpected[i]);
+            i++;
+        }
+        assert(i == 6 && broken.codePointCount() == 6);
+    }
+
+    // Test encoding
+    {
+        char buffer[cave::utf8::maxSequenceSize];
+        assert(cave::utf8::encode(U'A', buffer) == 1 && buffer[0] == 'A');
+        assert(cave::utf8::encode(0x20AC, buffer) == 3 && memcmp(buffer, "\xE2\x82\xAC", 3) == 0);
+        assert(cave::utf8::encode(0x1F600, buffer) == 4 && memcmp(buffer, "\xF0\x9F\x98\x80", 4) == 0);
+        assert(cave::utf8::encode(0xD800, buffer) == 3 && memcmp(buffer, "\xEF\xBF\xBD", 3) == 0);
+        assert(cave::utf8::encode(0x110000, buffer) == 3 && memcmp(buffer, "\xEF\xBF\xBD", 3) == 0);
+
+        cave::String str;
+        cave::utf8::appendCodePoint(str, U'a');
+        cave::utf8::appendCodePoint(str, 0xE9);
+        cave::utf8::appendCodePoint(str, 0x20AC);
+        cave::utf8::appendCodePoint(str, 0x1F600);
+        assert(str == mixed);
+    }
+
+    // Test transcoding
+    {
+        assert(cave::utf8::utf16Length(mixed) == 5); // The emoji is a surrogate pair.
+        char16_t utf16[5];
+        assert(cave::utf8::toUtf16(mixed, utf16) == 5);
+        assert(utf16[0] == u'a' && utf16[1] == 0xE9 && utf16[2] == 0x20AC);
+        assert(utf16[3] == 0xD83D && utf16[4] == 0xDE00);
+        assert(cave::utf8::fromUtf16(utf16, 5) == mixed);
+
+        char32_t utf32[4];
+        assert(cave::utf8::toUtf32(mixed, utf32) == 4);
+        assert(utf32[3] == 0x1F600);
+        assert(cave::utf8::fromUtf32(utf32, 4) == mixed);
+
+        // Unpaired surrogates and invalid code points:
+        const char16_t lonely[] = {u'x', 0xD83D, u'y', 0xDE00};
+        assert(cave::utf8::fromUtf16(lonely, 4) == "x\xEF\xBF\xBDy\xEF\xBF\xBD");
+        const char32_t badCodePoints[] = {0xDC00, 0x110000, U'z'};
+        assert(cave::utf8::fromUtf32(badCodePoints, 3) == "\xEF\xBF\xBD\xEF\xBF\xBDz");
+
+        assert(cave::utf8::fromUtf16(nullptr, 0).empty());
+    }
+
+    // Test random texts (mixing long ascii runs with everything else, so the
+    // SIMD paths and their tails are all used) against the scalar decoder.
+    {
+        std::mt19937 rng(42);
+        for (int round = 0; round < 300; round++){
+            cave::Vector<char32_t> codePoints;
+            const int count = int(rng() % 200);
+            for (int i = 0; i < count; i++){
+                const unsigned kind = rng() % 8;
+                if (kind < 4){
+                    const int run = int(rng() % 40);
+                    for (int k = 0; k < run; k++){
+                        codePoints.pushBack(char32_t(' ' + rng() % 95));
+                    }
+                }
+                else if (kind == 4){ codePoints.pushBack(char32_t(0x80 + rng() % 0x780)); }
+                else if (kind == 5){ codePoints.pushBack(char32_t(0x800 + rng() % 0xD000)); }
+                else if (kind == 6){ codePoints.pushBack(char32_t(0xE000 + rng() % 0x2000)); }
+                else { codePoints.pushBack(char32_t(0x10000 + rng() % 0x100000)); }
+            }
+            cave::String text;
+            for (size_t i = 0; i < codePoints.size(); i++){
+                cave::utf8::appendCodePoint(text, codePoints[i]);
+            }
+            assert(text.isValidUtf8());
+            assert(text.codePointCount() == codePoints.size());
+
+            cave::Vector<char32_t> utf32;
+            utf32.resize(text.codePointCount());
+            assert(cave::utf8::toUtf32(text, utf32.data()) == codePoints.size());
+            for (size_t i = 0; i < codePoints.size(); i++){
+                assert(utf32[i] == codePoints[i]);
+            }
+            assert(cave::utf8::fromUtf32(utf32.data(), utf32.size()) == text);
+
+            cave::Vector<char16_t> utf16;
+            utf16.resize(cave::utf8::utf16Length(text));
+            assert(cave::utf8::toUtf16(text, utf16.data()) == utf16.size());
+            assert(cave::utf8::fromUtf16(utf16.data(), utf16.size()) == text);
+
+            // Now break it in a random place:
+            if (!text.empty()){
+                cave::String broken = text;
+                broken[rng() % broken.size()] = char(0x80 + rng() % 0x80);
+                assert(broken.isValidUtf8() == utf8TestRoundTrips(broken));
+
+                size_t decoded = 0;
+                for (char32_t c : broken.codePoints()){
+                    (void)c;
+                    decoded++;
+                }
+                assert(broken.codePointCount() == decoded);
+                utf16.resize(cave::utf8::utf16Length(broken));
+                assert(cave::utf8::toUtf16(broken, utf16.data()) == utf16.size());
+            }
+        }
+    }
+
+    std::cout << "[UTF8] All tests passed!" << std::endl;
+}
+
+// Performance checks...
+
+#include <cstdio>
+#include <chrono>
+
+// Decodes one byte at a time, like our old text layout code did.
+inline size_t utf8TestNaiveDecode(const cave::String& text, char16_t* out, bool& valid) {
+    const unsigned char* s = (const unsigned char*)text.c_str();
+    const size_t n = text.size();
+    size_t written = 0;
+    valid = true;
+    for (size_t i = 0; i < n;){
+        char32_t c = s[i];
+        size_t extra = 0;
+        if (c >= 0xF0)      { c &= 0x07; extra = 3; }
+        else if (c >= 0xE0) { c &= 0x0F; extra = 2; }
+        else if (c >= 0xC0) { c &= 0x1F; extra = 1; }
+        else if (c >= 0x80) { valid = false; }
+        i++;
+        for (size_t k = 0; k < extra && i < n; k++, i++){
+            if ((s[i] & 0xC0) != 0x80){ valid = false; }
+            c = (c << 6) | (s[i] & 0x3F);
+        }
+        if (c >= 0x10000){
+            c -= 0x10000;
+            out[written++] = char16_t(0xD800 + (c >> 10));
+            out[written++] = char16_t(0xDC00 + (c & 0x3FF));
+        }
+        else {
+            out[written++] = char16_t(c);
+        }
+    }
+    return written;
+}
+
+void testUtf8Performance() {
+    const int N = 20;
+
+    // A localized text: mostly ascii (markup, numbers, latin languages) with
+    // some accents and a few CJK lines.
+    cave::String text;
+    for (int i = 0; i < 20000; i++){
+        text += "<label id=\"menu.options\">Options</label> ";
+        text += "Paramètres du jeu, éléments à débloquer. ";
+        if (i % 4 == 0){
+            text += "\xE8\xA8\xAD\xE5\xAE\x9A\xE3\x82\x92\xE4\xBF\x9D\xE5\xAD\x98 ";
+        }
+        text += '\n';
+    }
+
+    std::cout << " - (We'll be decoding " << text.size() / 1024 << " KB of text " << N << " times.)\n";
+
+    cave::Vector<char16_t> out;
+    out.resize(text.size());
+
+    printf("          | naive decoder | cave::utf8 |\n");
+    size_t dur1 = 0;
+    size_t dur2 = 0;
+
+    // Test validating + transcoding to UTF-16 (what the UI does at startup)
+    size_t units1 = 0;
+    size_t units2 = 0;
+    bool valid1 = true;
+    bool valid2 = true;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int n = 0; n < N; n++) {
+        bool valid = false;
+        units1 += utf8TestNaiveDecode(text, out.data(), valid);
+        valid1 = valid1 && valid;
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    dur1 = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+    start = std::chrono::high_resolution_clock::now();
+    for (int n = 0; n < N; n++) {
+        valid2 = valid2 && text.isValidUtf8();
+        units2 += cave::utf8::toUtf16(text, out.data());
+    }
+    end = std::chrono::high_resolution_clock::now();
+    dur2 = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    printf("   Decode | %10zu us | %7zu us |", dur1, dur2);
+    if (dur1 < dur2){ printf(" BAD!"); }
+    printf("\n");
+
+    assert(units1 == units2 && valid1 && valid2);
+
+    // Test counting the code points
+    size_t count1 = 0;
+    size_t count2 = 0;
+    start = std::chrono::high_resolution_clock::now();
+    for (int n = 0; n < N; n++) {
+        const unsigned char* s = (const unsigned char*)text.c_str();
+        for (size_t i = 0; i < text.size(); i++){
+            count1 += (s[i] & 0xC0) != 0x80;
+        }
+    }
+    end = std::chrono::high_resolution_clock::now();
+    dur1 = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+    start = std::chrono::high_resolution_clock::now();
+    for (int n = 0; n < N; n++) {
+        count2 += text.codePointCount();
+    }
+    end = std::chrono::high_resolution_clock::now();
+    dur2 = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    printf(" Counting | %10zu us | %7zu us |", dur1, dur2);
+    if (dur1 < dur2){ printf(" BAD!"); }
+    printf("\n");
+
+    assert(count1 == count2);
+}
@@ -1,11 +1,20 @@
 #pragma once
 
 #include <cassert>
+#include <cmath> // NAN
 #include <cstring>
 #include <iostream>
+#include <iterator> // std::iterator_traits
+#include <algorithm> // std::lower_bound, std::nth_element
+#include <type_traits>
+#include <chrono>
+#include <mutex>
+#include <thread>
 
 #include "Containers/Vector.h"
+#include "Containers/Pair.h"
 #include "Containers/Exception.h"
+#include "Containers/String.h"
 
 
 bool __sortReverseInts(int a, int b){
@@ -270,6 +279,336 @@ void testCaveVector() {
         }
     }
 
+    // Test range erase
+    {
+        cave::Vector<int> v1 = {0, 1, 2, 3, 4, 5, 6};
+        v1.erase(1, 4);
+        assert(v1.size() == 4);
+        assert(v1[0] == 0 && v1[1] == 4 && v1[2] == 5 && v1[3] == 6);
+
+        v1.erase(2, 1000);
+        assert(v1.size() == 2);
+        assert(v1[0] == 0 && v1[1] == 4);
+
+        v1.erase(1, 1);
+        assert(v1.size() == 2);
+    }
+
+    // Test eraseUnordered
+    {
+        cave::Vector<int> v1 = {0, 1, 2, 3};
+        v1.eraseUnordered(1);
+        assert(v1.size() == 3);
+        assert(v1[0] == 0 && v1[1] == 3 && v1[2] == 2);
+
+        v1.eraseUnordered(2);
+        assert(v1.size() == 2);
+        assert(v1[0] == 0 && v1[1] == 3);
+
+        // Out of range does nothing (it used to pop the last element):
+        v1.eraseUnordered(2);
+        v1.eraseUnordered(100);
+        assert(v1.size() == 2);
+        assert(v1[0] == 0 && v1[1] == 3);
+    }
+
+    // Test moving non trivial elements in (pushBack(T&&) constructs in place)
+    {
+        cave::Vector<cave::String> v1;
+        for (int i=0; i<100; i++){
+            cave::String str = "a long string that doesn't fit in the local buffer";
+            v1.pushBack(std::move(str));
+        }
+        assert(v1.size() == 100);
+        assert(v1[99] == "a long string that doesn't fit in the local buffer");
+    }
+
+    // Test removeIf
+    {
+        cave::Vector<int> v1;
+        for (int i=0; i<1000; i++){
+            v1.pushBack(i);
+        }
+        size_t removed = v1.removeIf([](int e){ return e % 3 != 0; });
+        assert(removed == 666);
+        assert(v1.size() == 334);
+        for (size_t i=0; i<v1.size(); i++){
+            assert(v1[i] == int(i * 3));
+        }
+        assert(v1.removeIf([](int){ return false; }) == 0);
+        assert(v1.size() == 334);
+    }
+
+    // Test parallelSort
+    {
+        cave::Vector<int> v1;
+        unsigned int seed = 1337;
+        for (int i=0; i<100000; i++){
+            seed = seed * 1103515245u + 12345u;
+            v1.pushBack(int(seed >> 8) % 50000);
+        }
+        cave::Vector<int> v2 = v1;
+        cave::Vector<int> v3 = v1;
+
+        v1.sort();
+        v2.parallelSort(4);
+        assert(v1 == v2);
+
+        v3.parallelSort(3, __sortReverseInts);
+        for (size_t i=0; i<v3.size(); i++){
+            assert(v3[i] == v1[v1.size() - 1 - i]);
+        }
+
+        // Small ones just fall back to sort()
+        cave::Vector<int> v4 = {4, 5, 1, 3, 2, 0};
+        v4.parallelSort();
+        for (int i=0; i<6; i++){
+            assert(v4[i] == i);
+        }
+    }
+
+    // Test a throwing task in the ThreadPool (the exception reaches the
+    // caller and the pool keeps working in parallel afterwards)
+    {
+        cave::ThreadPool pool(2);
+        bool thrown = false;
+        try {
+            pool.parallelFor(64, [](size_t i){
+                if (i == 10){
+                    throw cave::OutOfRangeException(i);
+                }
+            });
+        }
+        catch (const cave::OutOfRangeException&){
+            thrown = true;
+        }
+        assert(thrown);
+
+        std::mutex idsMutex;
+        cave::Vector<std::thread::id> ids;
+        pool.parallelFor(64, [&](size_t){
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            std::lock_guard<std::mutex> lock(idsMutex);
+            if (!ids.contains(std::this_thread::get_id())){
+                ids.pushBack(std::this_thread::get_id());
+            }
+        });
+        assert(ids.size() > 1);
+    }
+
+    // Test radixSort
+    {
+        cave::Vector<uint64_t> v1;
+        cave::Vector<int> v2;
+        cave::Vector<float> v3;
+        uint64_t seed = 7;
+        for (int i=0; i<5000; i++){
+            seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+            v1.pushBack(seed);
+            v2.pushBack(int(seed >> 33) - (1 << 30));
+            v3.pushBack(float(int64_t(seed >> 20) - (int64_t(1) << 43)) / 1000.0f);
+        }
+        v3.pushBack(0.0f);
+        v3.pushBack(-1.5f);
+
+        cave::Vector<uint64_t> sorted1 = v1;
+        cave::Vector<int> sorted2 = v2;
+        cave::Vector<float> sorted3 = v3;
+        sorted1.sort();
+        sorted2.sort();
+        sorted3.sort();
+
+        v1.radixSort();
+        v2.radixSort();
+        v3.radixSort();
+        assert(v1 == sorted1);
+        assert(v2 == sorted2);
+        assert(v3 == sorted3);
+
+        // Small keys, where most passes are skipped
+        cave::Vector<int8_t> v4 = {5, -3, 0, 127, -128, 1};
+        v4.radixSort();
+        cave::Vector<int8_t> cmp4 = {-128, -3, 0, 1, 5, 127};
+        assert(v4 == cmp4);
+    }
+
+    // Test radixSortBy (must be stable)
+    {
+        cave::Vector<cave::Pair<uint32_t, uint32_t>> v1;
+        for (uint32_t i=0; i<1000; i++){
+            v1.emplaceBack((i * 7919u) % 100u, i);
+        }
+        v1.radixSortBy([](const cave::Pair<uint32_t, uint32_t>& p){ return p.first; });
+
+        for (size_t i=1; i<v1.size(); i++){
+            assert(v1[i - 1].first <= v1[i].first);
+            if (v1[i - 1].first == v1[i].first){
+                assert(v1[i - 1].second < v1[i].second);
+            }
+        }
+    }
+
+    // Test the (SIMD) searching methods: findID, find, contains, count and minMax
+    {
+        auto check = [](auto sample){
+            using T = decltype(sample);
+            for (size_t n=0; n<70; n++){
+                cave::Vector<T> v1;
+                for (size_t i=0; i<n; i++){
+                    v1.pushBack(T((i * 37) % 23));
+                }
+                for (int value=-1; value<25; value++){
+                    size_t expectedID = cave::Vector<T>::npos;
+                    size_t expectedCount = 0;
+                    for (size_t i=0; i<n; i++){
+                        if (v1[i] == T(value)){
+                            if (expectedCount++ == 0){ expectedID = i; }
+                        }
+                    }
+                    assert(v1.findID(T(value)) == expectedID);
+                    assert(v1.contains(T(value)) == (expectedID != cave::Vector<T>::npos));
+                    assert(v1.count(T(value)) == expectedCount);
+                    if (expectedID == cave::Vector<T>::npos){
+                        assert(v1.find(T(value)) == v1.end());
+                    }
+                    else {
+                        assert(v1.find(T(value)) == v1.begin() + int(expectedID));
+                    }
+                }
+                if (n > 0){
+                    v1[n / 2] = T(100);
+                    v1[n - 1] = T(-3);
+                    auto mm = v1.minMax();
+                    T mn = v1[0], mx = v1[0];
+                    for (auto e : v1){
+                        if (e < mn){ mn = e; }
+                        if (e > mx){ mx = e; }
+                    }
+                    assert(mm.first == mn);
+                    assert(mm.second == mx);
+                }
+            }
+        };
+        check(int(0));
+        check(uint32_t(0));
+        check(float(0));
+        check(double(0));
+        check(int8_t(0));
+        check(uint16_t(0));
+        check(int64_t(0));
+
+        // Floats follow operator== (-0 == +0, NaN != NaN)
+        cave::Vector<float> v2 = {1.0f, -0.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f, NAN};
+        assert(v2.findID(0.0f) == 1);
+        assert(v2.count(NAN) == 0);
+        assert(v2.minMax().first == -0.0f);
+        assert(v2.minMax().second == 8.0f);
+
+        cave::Vector<int> empty;
+        assert(empty.findID(1) == cave::Vector<int>::npos);
+        assert(empty.count(1) == 0);
+        try {
+            empty.minMax();
+            assert(false);
+        } catch (cave::OutOfRangeException&) {
+            assert(true);
+        }
+
+        // Non arithmetic types still work (scalar)
+        cave::Vector<cave::Pair<int, int>> v3;
+        v3.emplaceBack(1, 2);
+        v3.emplaceBack(3, 4);
+        assert(v3.findID(cave::Pair<int, int>(3, 4)) == 1);
+        assert(v3.count(cave::Pair<int, int>(1, 2)) == 1);
+    }
+
+    // Test resizeDefaultInit and resizeUninitialized
+    {
+        cave::Vector<int> v1 = {1, 2, 3};
+        v1.resizeDefaultInit(100);
+        assert(v1.size() == 100);
+        assert(v1[0] == 1 && v1[1] == 2 && v1[2] == 3);
+
+        v1.resizeUninitialized(200);
+        assert(v1.size() == 200);
+        assert(v1.capacity() >= 200);
+        assert(v1[2] == 3);
+
+        v1.resizeUninitialized(2);
+        assert(v1.size() == 2);
+        assert(v1.back() == 2);
+    }
+
+    // Test appendFrom
+    {
+        const char* src = "cave engine";
+        size_t offset = 0;
+
+        cave::Vector<char> v1;
+        // Reading it in small chunks, like you would do with fread...
+        while (true){
+            size_t read = v1.appendFrom(4, [&](char* dst, size_t n){
+                size_t left = strlen(src) - offset;
+                size_t count = left < n ? left : n;
+                if (count > 0){
+                    memcpy(dst, src + offset, count);
+                }
+                offset += count;
+                return count;
+            });
+            if (read == 0){ break; }
+        }
+        assert(v1.size() == strlen(src));
+        assert(memcmp(v1.data(), src, v1.size()) == 0);
+    }
+
+    // Test the iterators with the std algorithms
+    {
+        using It = cave::Vector<int>::Iterator;
+        using CIt = cave::Vector<int>::ConstIterator;
+        static_assert(std::is_same<std::iterator_traits<It>::iterator_category, std::random_access_iterator_tag>::value, "");
+        static_assert(std::is_same<std::iterator_traits<CIt>::reference, const int&>::value, "");
+        static_assert(std::is_same<decltype(std::declval<const cave::Vector<int>&>().begin()), CIt>::value, "");
+
+        cave::Vector<int> v1;
+        for (int i=0; i<100; i++){
+            v1.pushBack((i * 37) % 100);
+        }
+        std::nth_element(v1.begin(), v1.begin() + 50, v1.end());
+        assert(v1[50] == 50);
+
+        v1.sort();
+        const cave::Vector<int>& cv1 = v1;
+        CIt lb = std::lower_bound(cv1.begin(), cv1.end(), 42);
+        assert(lb - cv1.begin() == 42);
+        assert(*lb == 42 && lb[1] == 43);
+        assert(cv1.begin() < lb && lb <= cv1.end() && !(lb > cv1.end()));
+        assert(2 + cv1.begin() == cv1.begin() + 2);
+
+        // Iterator -> ConstIterator, and comparing both:
+        CIt it = v1.begin();
+        assert(it == v1.begin());
+        assert(cv1.find(10) == v1.begin() + 10);
+        *v1.find(10) = 1000;
+        assert(cv1[10] == 1000);
+        v1[10] = 10;
+
+        // Binary searches:
+        assert(v1.lowerBound(42) == 42);
+        v1.pushBack(2000);
+        v1.pushBack(2000);
+        assert(v1.lowerBound(2000) == 100);
+        assert(v1.upperBound(2000) == 102);
+        assert(v1.lowerBound(5000) == v1.size());
+        assert(v1.lowerBound(-1) == 0);
+        assert(v1.lowerBound(98, __sortReverseInts) == 0);
+
+        cave::Vector<cave::Pair<int, int>> v2 = {{1, 2}, {3, 4}};
+        assert(v2.begin()->second == 2);
+        v2.erase(v2.begin());
+        assert(v2.size() == 1 && v2[0].first == 3);
+    }
+
     std::cout << "[VECTOR] All tests passed!" << std::endl;
 }
 
@@ -380,6 +719,48 @@ void testCaveVectorBehavior() {
     //assert(VectorTestMock::moveCtorCount == 3);
     assert(VectorTestMock::dtorCount == 6);
 
+    // Test resize (shrinking) and resizeDefaultInit
+    VectorTestMock::defaultCtorCunt = 0;
+    VectorTestMock::dtorCount = 0;
+    {
+        cave::Vector<VectorTestMock> vec;
+        vec.resizeDefaultInit(4);
+        assert(VectorTestMock::defaultCtorCunt == 4);
+
+        vec.resize(1);
+        assert(VectorTestMock::dtorCount == 3);
+    }
+    assert(VectorTestMock::dtorCount == 4);
+
+    // Test that erasing destroys exactly what it removes (no leaked or
+    // double destroyed objects, even when shifting things around)
+    VectorTestMock::defaultCtorCunt = 0;
+    VectorTestMock::copyCtorCount = 0;
+    VectorTestMock::moveCtorCount = 0;
+    VectorTestMock::dtorCount = 0;
+    {
+        auto alive = [](){
+            return VectorTestMock::defaultCtorCunt + VectorTestMock::copyCtorCount
+                + VectorTestMock::moveCtorCount - VectorTestMock::dtorCount;
+        };
+        cave::Vector<VectorTestMock> vec;
+        vec.resize(10);
+        vec.erase(2, 5);
+        assert(vec.size() == 7);
+        assert(alive() == 7);
+
+        vec.eraseUnordered(0);
+        assert(vec.size() == 6);
+        assert(alive() == 6);
+
+        int i = 0;
+        vec.removeIf([&](const VectorTestMock&){ return (i++ % 2) == 0; });
+        assert(vec.size() == 3);
+        assert(alive() == 3);
+    }
+    assert(VectorTestMock::defaultCtorCunt + VectorTestMock::copyCtorCount
+        + VectorTestMock::moveCtorCount == VectorTestMock::dtorCount);
+
     // Test how it behaves with pointers...
     VectorTestPtrMock* ptr = new VectorTestPtrMock();
     try {
@@ -463,7 +844,32 @@ void testVectorPerformance() {
     printf("\n");
 
     assert(count1 == count2); // Little assert just to make sure...
-    
+
+
+    // Test finding performance (the last element, a few times)
+    start = std::chrono::high_resolution_clock::now();
+    size_t found1 = 0;
+    for (int i = 0; i < 10; i++) {
+        found1 += std::find(v1.begin(), v1.end(), N - 1 - i) - v1.begin();
+    }
+    end = std::chrono::high_resolution_clock::now();
+    duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+    dur1 = duration.count();
+
+    start = std::chrono::high_resolution_clock::now();
+    size_t found2 = 0;
+    for (int i = 0; i < 10; i++) {
+        found2 += v2.findID(N - 1 - i);
+    }
+    end = std::chrono::high_resolution_clock::now();
+    duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+    dur2 = duration.count();
+    printf("  Finding | %9zu us | %9zu us |", dur1, dur2);
+    if (dur1 < dur2){ printf(" BAD!"); }
+    printf("\n");
+
+    assert(found1 == found2); // Little assert just to make sure...
+
 
     // Test removing performance
     start = std::chrono::high_resolution_clock::now();
@@ -486,3 +892,80 @@ void testVectorPerformance() {
     if (dur1 < dur2){ printf(" BAD!"); }
     printf("\n");
 }
+
+
+void testVectorSortPerformance() {
+    const int N = 1000000;
+
+    std::cout << " - (We'll be testing it with " << N << " elements.)\n";
+
+    printf("          |    std::sort | parallelSort |\n");
+    size_t dur1 = 0;
+    size_t dur2 = 0;
+
+    std::vector<int> v1;
+    cave::Vector<int> v2;
+    v1.reserve(N);
+    v2.reserve(N);
+
+    unsigned int seed = 42;
+    for (int i = 0; i < N; i++) {
+        seed = seed * 1103515245u + 12345u;
+        v1.push_back(int(seed >> 1));
+        v2.pushBack(int(seed >> 1));
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+    std::sort(v1.begin(), v1.end());
+    auto end = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+    dur1 = duration.count();
+
+    start = std::chrono::high_resolution_clock::now();
+    v2.parallelSort();
+    end = std::chrono::high_resolution_clock::now();
+    duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+    dur2 = duration.count();
+    printf("  Sorting | %9zu us | %9zu us |", dur1, dur2);
+    if (dur1 < dur2){ printf(" BAD!"); }
+    printf(" (%zu threads)\n", cave::ThreadPool::shared().threadCount() + 1);
+
+    for (int i = 0; i < N; i++) {
+        assert(v1[i] == v2[i]); // Little assert just to make sure...
+    }
+}
+
+void testVectorRadixSortPerformance() {
+    printf("          |  Vector::sort |   radixSort  |\n");
+
+    for (size_t n = 1000; n <= 10000000; n *= 10) {
+        size_t dur1 = 0;
+        size_t dur2 = 0;
+
+        cave::Vector<uint64_t> v1;
+        v1.resizeUninitialized(n);
+        uint64_t seed = 42;
+        for (size_t i = 0; i < n; i++) {
+            seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+            v1[i] = seed;
+        }
+        cave::Vector<uint64_t> v2 = v1;
+
+        auto start = std::chrono::high_resolution_clock::now();
+        v1.sort();
+        auto end = std::chrono::high_resolution_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+        dur1 = duration.count();
+
+        start = std::chrono::high_resolution_clock::now();
+        v2.radixSort();
+        end = std::chrono::high_resolution_clock::now();
+        duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+        dur2 = duration.count();
+        printf(" %8zu | %10zu us | %10zu us |", n, dur1, dur2);
+        if (dur1 < dur2){ printf(" BAD!"); }
+        printf("\n");
+
+        assert(v1 == v2); // Little assert just to make sure...
+    }
+}
@@ -1,25 +1,83 @@
 #include <iostream>
 
 #include "Containers/StringTests.h"
+#include "Containers/StringViewTests.h"
+#include "Containers/StringBuilderTests.h"
+#include "Containers/StringNumbersTests.h"
+#include "Containers/FormatTests.h"
+#include "Containers/Utf8Tests.h"
+#include "Containers/NameTests.h"
+#include "Containers/SharedStringTests.h"
 #include "Containers/VectorTests.h"
+#include "Containers/SoAVectorTests.h"
+#include "Containers/StableVectorTests.h"
+#include "Containers/MappedVectorTests.h"
+#include "Containers/CompactVectorTests.h"
+#include "Containers/StaticVectorTests.h"
+#include "Containers/EytzingerArrayTests.h"
+#include "Containers/BitVectorTests.h"
 #include "Containers/ListTests.h"
+#include "Containers/DequeTests.h"
 #include "Containers/HashMapTests.h"
 #include "Containers/PairTests.h"
+#include "Containers/SlotMapTests.h"
 
 int main(){
     // Running the String tests:
     testCaveString();    
+    testCaveStringView();
+    testCaveStringBuilder();
+    testCaveStringNumbers();
+    testCaveFormat();
+    testCaveUtf8();
+
+    std::cout << "\n";
+    // Running the Name (interned string) and Shared String tests:
+    testCaveName();
+    testCaveSharedString();
 
     std::cout << "\n";
     // Running the Vector tests:
     testCaveVector();
     testCaveVectorBehavior();
 
+    std::cout << "\n";
+    // Running the Structure of Arrays Vector tests:
+    testCaveSoAVector();
+
+    std::cout << "\n";
+    // Running the Stable (segmented) Vector tests:
+    testCaveStableVector();
+
+    std::cout << "\n";
+    // Running the Memory Mapped Vector tests:
+    testCaveMappedVector();
+
+    std::cout << "\n";
+    // Running the Compact Vector tests:
+    testCaveCompactVector();
+
+    std::cout << "\n";
+    // Running the Static (fixed capacity) Vector tests:
+    testCaveStaticVector();
+
+    std::cout << "\n";
+    // Running the Eytzinger (BFS ordered) Array tests:
+    testCaveEytzingerArray();
+
+    std::cout << "\n";
+    // Running the Bit Vector (bitset) tests:
+    testCaveBitVector();
+
     std::cout << "\n";
     // Running the Linked List tests:
     testCaveList();
     testCaveListIterator();
 
+    std::cout << "\n";
+    // Running the Deque (ring buffer) tests:
+    testCaveDeque();
+
     std::cout << "\n";
     // Running the Pair tests:
     testCavePair();
@@ -29,6 +87,10 @@ int main(){
     testCaveHashMap();
     testCaveHashMapBehavior();
 
+    std::cout << "\n";
+    // Running the Slot Map tests:
+    testCaveSlotMap();
+
 
     std::cout << "\n";
     std::cout << "------------------------------------\n";
@@ -38,14 +100,53 @@ int main(){
     std::cout << "\n";
     testStringPerformance();
 
+    std::cout << "\n";
+    testStringBuilderPerformance();
+
+    std::cout << "\n";
+    testStringNumbersPerformance();
+
+    std::cout << "\n";
+    testFormatPerformance();
+
+    std::cout << "\n";
+    testUtf8Performance();
+
+    std::cout << "\n";
+    testNamePerformance();
+
+    std::cout << "\n";
+    testSharedStringPerformance();
+
     std::cout << "\n";
     testListPerformance();
 
+    std::cout << "\n";
+    testDequePerformance();
+
     std::cout << "\n";
     testVectorPerformance();
 
+    std::cout << "\n";
+    testVectorSortPerformance();
+
+    std::cout << "\n";
+    testVectorRadixSortPerformance();
+
+    std::cout << "\n";
+    testEytzingerArrayPerformance();
+
+    std::cout << "\n";
+    testBitVectorPerformance();
+
+    std::cout << "\n";
+    testStableVectorPerformance();
+
     std::cout << "\n";
     testHashMapPerformance();
+
+    std::cout << "\n";
+    testSlotMapPerformance();
     
     return 0;
 }
\ No newline at end of file